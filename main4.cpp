@@ -1,33 +1,590 @@
 #include <iostream>
 #include <vector>
+#include <array>
 #include <string>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <ctime>
 #include <iomanip>
 #include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <sstream>
+#include <initializer_list>
+#include <new>
+#include <utility>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <deque>
+#include <memory>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/uio.h>
+#else
+#include <direct.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+class OutputSilencer {
+private:
+    NullBuffer sink;
+    streambuf* saved;
+
+public:
+    OutputSilencer() : saved(cout.rdbuf(&sink)) {}
+    ~OutputSilencer() { cout.rdbuf(saved); }
+};
+
+class OutputSink {
+private:
+    static const size_t DEFAULT_CAPACITY = 64 * 1024;
+    static constexpr size_t NUMBER_ROOM = 32;
+
+    unique_ptr<char[]> buffer;
+    size_t capacity;
+    size_t used;
+
+    char* reserve(size_t size) {
+        if (size > capacity - used) {
+            flush();
+        }
+        return buffer.get() + used;
+    }
+
+protected:
+    virtual void emit(const char* data, size_t size) = 0;
+
+    void discard() { used = 0; }
+
+public:
+    explicit OutputSink(size_t size = DEFAULT_CAPACITY) : capacity(max(size, NUMBER_ROOM)), used(0) {
+        buffer.reset(new char[capacity]);
+    }
+    virtual ~OutputSink() {}
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    void write(const char* data, size_t size) {
+        if (size > capacity - used) {
+            flush();
+            if (size >= capacity) {
+                emit(data, size);
+                return;
+            }
+        }
+        memcpy(buffer.get() + used, data, size);
+        used += size;
+    }
+
+    void flush() {
+        if (used > 0) {
+            emit(buffer.get(), used);
+            used = 0;
+        }
+    }
+
+    OutputSink& operator<<(const string& text) {
+        write(text.data(), text.size());
+        return *this;
+    }
+
+    OutputSink& operator<<(const char* text) {
+        write(text, strlen(text));
+        return *this;
+    }
+
+    OutputSink& operator<<(char c) {
+        *reserve(1) = c;
+        ++used;
+        return *this;
+    }
+
+    template <typename T>
+    typename enable_if<is_integral<T>::value && !is_same<T, bool>::value, OutputSink&>::type operator<<(T value) {
+        char* first = reserve(NUMBER_ROOM);
+        used = to_chars(first, first + NUMBER_ROOM, value).ptr - buffer.get();
+        return *this;
+    }
+
+    // Same digits as the default ostream float format (%g, six significant digits).
+    OutputSink& operator<<(double value) {
+        char* first = reserve(NUMBER_ROOM);
+#if defined(__cpp_lib_to_chars)
+        used = to_chars(first, first + NUMBER_ROOM, value, chars_format::general, 6).ptr - buffer.get();
+#else
+        used += snprintf(first, NUMBER_ROOM, "%g", value);
+#endif
+        return *this;
+    }
+
+    OutputSink& operator<<(float value) { return *this << double(value); }
+};
+
+class StreamSink : public OutputSink {
+private:
+    ostream& out;
+
+protected:
+    void emit(const char* data, size_t size) override { out.write(data, size); }
+
+public:
+    explicit StreamSink(ostream& stream) : out(stream) {}
+    ~StreamSink() override { flush(); }
+};
+
+class StringSink : public OutputSink {
+private:
+    string text;
+
+protected:
+    void emit(const char* data, size_t size) override { text.append(data, size); }
+
+public:
+    explicit StringSink(size_t capacity = 16 * 1024) : OutputSink(capacity) {}
+
+    const string& str() {
+        flush();
+        return text;
+    }
+
+    string take() {
+        flush();
+        string result;
+        result.swap(text);
+        return result;
+    }
+
+    void clear() {
+        discard();
+        text.clear();
+    }
+};
+
+enum class ListingFormat { Json, Csv };
+
+inline bool parseListingFormat(const string& name, ListingFormat& format) {
+    if (name == "json") {
+        format = ListingFormat::Json;
+    } else if (name == "csv") {
+        format = ListingFormat::Csv;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Streams rows of a fixed set of columns; a row ends after its last column is written.
+class ListingEncoder {
+private:
+    OutputSink& out;
+    ListingFormat format;
+    vector<string> columns;
+    size_t column;
+    bool anyRow;
+
+    void beginField() {
+        if (format == ListingFormat::Csv) {
+            if (column > 0) {
+                out << ',';
+            }
+            return;
+        }
+        out << (column > 0 ? "," : anyRow ? ",\n{" : "\n{");
+        writeJsonString(columns[column]);
+        out << ':';
+    }
+
+    void endField() {
+        if (++column < columns.size()) {
+            return;
+        }
+        out << (format == ListingFormat::Csv ? "\n" : "}");
+        column = 0;
+        anyRow = true;
+    }
+
+    void writeJsonString(const string& value) {
+        out << '"';
+        size_t start = 0;
+        for (size_t i = 0; i < value.size(); ++i) {
+            unsigned char c = value[i];
+            if (c != '"' && c != '\\' && c >= 0x20) {
+                continue;
+            }
+            out.write(value.data() + start, i - start);
+            start = i + 1;
+            if (c == '"' || c == '\\') {
+                out << '\\' << char(c);
+            } else if (c == '\n') {
+                out << "\\n";
+            } else if (c == '\t') {
+                out << "\\t";
+            } else if (c == '\r') {
+                out << "\\r";
+            } else {
+                char escape[8];
+                snprintf(escape, sizeof(escape), "\\u%04x", c);
+                out << escape;
+            }
+        }
+        out.write(value.data() + start, value.size() - start);
+        out << '"';
+    }
+
+    void writeCsvString(const string& value) {
+        if (value.find_first_of(",\"\r\n") == string::npos) {
+            out << value;
+            return;
+        }
+        out << '"';
+        size_t start = 0;
+        for (size_t quote; (quote = value.find('"', start)) != string::npos; start = quote + 1) {
+            out.write(value.data() + start, quote + 1 - start);
+            out << '"';
+        }
+        out.write(value.data() + start, value.size() - start);
+        out << '"';
+    }
+
+public:
+    ListingEncoder(OutputSink& sink, ListingFormat listingFormat, initializer_list<const char*> names)
+        : out(sink), format(listingFormat), columns(names.begin(), names.end()), column(0), anyRow(false) {
+        if (format == ListingFormat::Json) {
+            out << '[';
+            return;
+        }
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) {
+                out << ',';
+            }
+            writeCsvString(columns[i]);
+        }
+        out << '\n';
+    }
+
+    ListingEncoder& field(const string& value) {
+        beginField();
+        if (format == ListingFormat::Json) {
+            writeJsonString(value);
+        } else {
+            writeCsvString(value);
+        }
+        endField();
+        return *this;
+    }
+
+    ListingEncoder& field(const char* value) { return field(string(value)); }
+
+    template <typename T>
+    ListingEncoder& field(T value) {
+        beginField();
+        if (format == ListingFormat::Json && !isfinite(double(value))) {
+            out << "null";
+        } else {
+            out << value;
+        }
+        endField();
+        return *this;
+    }
+
+    ListingEncoder& field(bool value) {
+        beginField();
+        out << (format == ListingFormat::Json ? (value ? "true" : "false") : (value ? "1" : "0"));
+        endField();
+        return *this;
+    }
+
+    void finish() {
+        if (format == ListingFormat::Json) {
+            out << (anyRow ? "\n]\n" : "]\n");
+        }
+        out.flush();
+    }
+};
+
+class WriteAheadLog {
+private:
+    ofstream outFile;
+    size_t recordCount;
+    bool suspended;
+    mutable mutex appendLock;
+
+    void closeFile() {
+        if (outFile.is_open()) {
+            outFile.close();
+        }
+        recordCount = 0;
+    }
+
+    template <typename Fields>
+    void appendFields(const Fields& fields) {
+        lock_guard<mutex> guard(appendLock);
+        if (suspended) {
+            return;
+        }
+        writeFields(outFile, fields);
+        outFile.flush();
+        ++recordCount;
+    }
+
+    template <typename Fields>
+    static void writeFields(ostream& out, const Fields& fields) {
+        bool first = true;
+        for (const auto& field : fields) {
+            if (!first) {
+                out << '\t';
+            }
+            first = false;
+            const string& text = field;
+            size_t start = 0;
+            for (size_t i = 0; i < text.size(); ++i) {
+                if (text[i] == '\t' || text[i] == '\n' || text[i] == '\r') {
+                    out.write(text.data() + start, i - start);
+                    out << ' ';
+                    start = i + 1;
+                }
+            }
+            out.write(text.data() + start, text.size() - start);
+        }
+        out << '\n';
+    }
+
+public:
+    WriteAheadLog() : recordCount(0), suspended(false) {}
+
+    void suspend() {
+        lock_guard<mutex> guard(appendLock);
+        suspended = true;
+    }
+
+    bool open(const string& path, uint32_t generation, bool truncate) {
+        lock_guard<mutex> guard(appendLock);
+        closeFile();
+        suspended = false;
+        outFile.open(path, truncate ? ios::trunc : ios::app);
+        if (!outFile) {
+            return false;
+        }
+        if (truncate) {
+            outFile << "#sis-log\t" << generation << "\n";
+            outFile.flush();
+        }
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> guard(appendLock);
+        closeFile();
+    }
+
+    bool isOpen() const { return outFile.is_open(); }
+    size_t size() const {
+        lock_guard<mutex> guard(appendLock);
+        return recordCount;
+    }
+
+    void append(initializer_list<string> fields) {
+        appendFields(fields);
+    }
+
+    void append(const vector<string>& fields) {
+        appendFields(fields);
+    }
+
+    static void writeRecord(ostream& out, initializer_list<string> fields) {
+        writeFields(out, fields);
+    }
+
+    static void writeRecord(ostream& out, const vector<string>& fields) {
+        writeFields(out, fields);
+    }
+
+    static vector<string> split(const string& line) {
+        vector<string> fields;
+        size_t start = 0;
+        while (true) {
+            size_t end = line.find('\t', start);
+            fields.push_back(line.substr(start, end == string::npos ? string::npos : end - start));
+            if (end == string::npos) {
+                break;
+            }
+            start = end + 1;
+        }
+        return fields;
+    }
+};
+
+template <typename T>
+class PublishedView {
+private:
+    struct Version {
+        uint64_t number;
+        T data;
+    };
+
+    shared_ptr<const Version> current;
+    atomic<uint64_t> writes;
+    mutex rebuildLock;
+
+public:
+    PublishedView() : writes(0) {}
+
+    PublishedView(const PublishedView&) = delete;
+    PublishedView& operator=(const PublishedView&) = delete;
+
+    void invalidate() { writes.fetch_add(1, memory_order_release); }
+
+    template <typename Build>
+    shared_ptr<const T> get(Build build) {
+        uint64_t wanted = writes.load(memory_order_acquire);
+        shared_ptr<const Version> version = atomic_load(&current);
+        if (!version || version->number != wanted) {
+            lock_guard<mutex> guard(rebuildLock);
+            version = atomic_load(&current);
+            if (!version || version->number != wanted) {
+                auto rebuilt = make_shared<Version>();
+                rebuilt->number = wanted;
+                build(rebuilt->data);
+                version = rebuilt;
+                atomic_store(&current, version);
+            }
+        }
+        return shared_ptr<const T>(version, &version->data);
+    }
+};
+
+template <typename T>
+class ObjectPool {
+private:
+    static const size_t BLOCK_SIZE = 1024;
+    vector<T*> blocks;
+    size_t count;
+
+public:
+    class iterator {
+    private:
+        const ObjectPool* pool;
+        size_t index;
+
+    public:
+        iterator(const ObjectPool* p, size_t i) : pool(p), index(i) {}
+        T& operator*() const { return (*pool)[index]; }
+        T* operator->() const { return &(*pool)[index]; }
+        iterator& operator++() { ++index; return *this; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+
+    ObjectPool() : count(0) {}
+
+    ~ObjectPool() { clear(); }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    T& create(Args&&... args) {
+        if (count == blocks.size() * BLOCK_SIZE) {
+            blocks.push_back(static_cast<T*>(::operator new(sizeof(T) * BLOCK_SIZE)));
+        }
+        T* slot = blocks[count / BLOCK_SIZE] + count % BLOCK_SIZE;
+        new (slot) T(std::forward<Args>(args)...);
+        ++count;
+        return *slot;
+    }
+
+    T& operator[](size_t i) const { return blocks[i / BLOCK_SIZE][i % BLOCK_SIZE]; }
+
+    size_t size() const { return count; }
+    size_t reservedBytes() const { return blocks.size() * BLOCK_SIZE * sizeof(T); }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, count); }
+
+    void clear() {
+        for (size_t i = count; i > 0; --i) {
+            (*this)[i - 1].~T();
+        }
+        for (T* block : blocks) {
+            ::operator delete(block);
+        }
+        blocks.clear();
+        count = 0;
+    }
+};
+
+inline size_t stringHeapBytes(const string& value) {
+    return value.capacity() > 15 ? value.capacity() + 1 : 0;
+}
+
+template <typename K, typename V>
+size_t mapNodeBytes(const map<K, V>& values) {
+    return values.size() * (sizeof(typename map<K, V>::value_type) + 4 * sizeof(void*));
+}
+
+class Student;
+class Faculty;
+
 class User {
 protected:
     string username;
     string password;
     string role; 
+    WriteAheadLog* journal;
 
 public:
-    User(string u, string p, string r) : username(u), password(p), role(r) {}
+    User(string u, string p, string r) : username(u), password(p), role(r), journal(nullptr) {}
 
     virtual ~User  () {}
 
-    string getUsername() const { return username; }
-    string getPassword() const { return password; }
-    string getRole() const { return role; }
+    const string& getUsername() const { return username; }
+    const string& getPassword() const { return password; }
+    const string& getRole() const { return role; }
 
-    bool checkLogin(string u, string p) const {
+    bool checkLogin(const string& u, const string& p) const {
         return (username == u && password == p);
     }
 
+    void setJournal(WriteAheadLog* log) { journal = log; }
+
+    virtual void writeState(ostream&) const {}
+
+    virtual Student* asStudent() { return nullptr; }
+    virtual Faculty* asFaculty() { return nullptr; }
+
     virtual void menu() = 0;
 };
 
@@ -57,948 +614,6204 @@ private:
 public:
     Course(string code, string name) : courseCode(code), courseName(name) {}
 
-    string getCourseCode() const { return courseCode; }
-    string getCourseName() const { return courseName; }
+    const string& getCourseCode() const { return courseCode; }
+    const string& getCourseName() const { return courseName; }
 
-    void displayCourse() const {
-        cout << "Course Code: " << courseCode << ", Course Name: " << courseName << "\n";
+    void rename(const string& name) { courseName = name; }
+
+    void displayCourse(OutputSink& out) const {
+        out << "Course Code: " << courseCode << ", Course Name: " << courseName << "\n";
     }
 };
 
-class Fee {
+typedef uint32_t CourseId;
+
+// Every course code is interned once; students, faculty and the gradebook hold the dense CourseId.
+class CourseRegistry {
 private:
-    float totalAmount;
-    float paidAmount;
+    vector<Course> catalog;
+    unordered_map<string, CourseId> index;
 
 public:
-    Fee(float total) : totalAmount(total), paidAmount(0) {}
-
-    void makePayment(float amount) {
-        if (paidAmount + amount <= totalAmount) {
-            paidAmount += amount;
-            cout << "Payment of $" << amount << " successful. Total Paid: $" << paidAmount << "\n";
-            displayDueAmount();
-        } else {
-            cout << "Payment exceeds total amount due!\n";
+    CourseId intern(const string& code, const string& name = "") {
+        auto it = index.find(code);
+        if (it != index.end()) {
+            if (!name.empty() && catalog[it->second].getCourseName().empty()) {
+                catalog[it->second].rename(name);
+            }
+            return it->second;
         }
+        CourseId id = CourseId(catalog.size());
+        catalog.emplace_back(code, name);
+        index.emplace(code, id);
+        return id;
     }
 
-    void viewFees() const {
-        cout << "Total Amount: $" << totalAmount << ", Amount Paid: $" << paidAmount << "\n";
-        displayDueAmount(); 
+    bool find(const string& code, CourseId& id) const {
+        auto it = index.find(code);
+        if (it == index.end()) {
+            return false;
+        }
+        id = it->second;
+        return true;
     }
 
-    void displayDueAmount() const {
-        float dueAmount = totalAmount - paidAmount;
-        cout << "Amount Due: $" << dueAmount << "\n";
-    }
+    const Course& course(CourseId id) const { return catalog[id]; }
+    const string& code(CourseId id) const { return catalog[id].getCourseCode(); }
+    size_t size() const { return catalog.size(); }
 
-    bool isPaidInFull() const {
-        return paidAmount >= totalAmount;
+    size_t heapBytes() const {
+        size_t bytes = catalog.capacity() * sizeof(Course) + index.bucket_count() * sizeof(void*);
+        for (const auto& course : catalog) {
+            bytes += 2 * stringHeapBytes(course.getCourseCode()) + stringHeapBytes(course.getCourseName());
+            bytes += sizeof(pair<const string, CourseId>) + sizeof(void*);
+        }
+        return bytes;
     }
-
-    float getTotalAmount() const { return totalAmount; } 
 };
 
-class Student : public User {
+// Student <-> course adjacency in compressed sparse rows, rebuilt lazily from the append-only edge list.
+// Edges added since the last build sit in a hash set so membership checks never wait for a rebuild.
+class EnrollmentIndex {
 private:
-    int id;
-    int age;
-    string course;
-    float finalGrade;
-    vector<Course> enrolledCourses;
-    map<string, int> attendance;
-    map<string, map<string, float>> examScores;
-    Fee* feeInfo; 
+    static constexpr size_t MIN_PENDING = 4096;
 
-public:
-    Student(string u, string p, int id, int age, string course, float feeAmount)
-        : User(u, p, "student"), id(id), age(age), course(course), finalGrade(0.0) {
-        feeInfo = new Fee(feeAmount); 
-    }
+    unordered_map<int, uint32_t> studentRows;
+    vector<int> studentIds;
+    vector<pair<uint32_t, CourseId>> edges;
+    vector<uint32_t> headcounts;
+    unordered_map<string, uint32_t> facultyRows;
+    vector<string> facultyNames;
+    vector<vector<CourseId>> taught;
+    vector<vector<uint32_t>> teachers;
+    mutable mutex indexLock;
+
+    mutable vector<uint32_t> studentOffsets;
+    mutable vector<CourseId> studentCourses;
+    mutable vector<uint32_t> courseOffsets;
+    mutable vector<uint32_t> courseStudents;
+    mutable size_t builtEdges;
+    mutable unordered_set<uint64_t> pending;
 
-    ~Student() {
-        delete feeInfo; 
+    static uint64_t key(int studentId, CourseId course) {
+        return (uint64_t(uint32_t(studentId)) << 32) | course;
     }
 
-    int getId() const { return id; }
-    int getAge() const { return age; } 
-    string getCourse() const { return course; }
-    float getFeeAmount() const { return feeInfo->getTotalAmount(); }
-    
-    void setFinalGrade(float grade) {
-        finalGrade = grade;
+    void rebuild() const {
+        size_t rows = studentIds.size(), courses = headcounts.size();
+        studentOffsets.assign(rows + 1, 0);
+        courseOffsets.assign(courses + 1, 0);
+        for (const auto& edge : edges) {
+            ++studentOffsets[edge.first + 1];
+            ++courseOffsets[edge.second + 1];
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            studentOffsets[i + 1] += studentOffsets[i];
+        }
+        for (size_t i = 0; i < courses; ++i) {
+            courseOffsets[i + 1] += courseOffsets[i];
+        }
+        studentCourses.resize(edges.size());
+        vector<uint32_t> fill(studentOffsets.begin(), studentOffsets.end() - 1);
+        for (const auto& edge : edges) {
+            studentCourses[fill[edge.first]++] = edge.second;
+        }
+        for (size_t row = 0; row < rows; ++row) {
+            sort(studentCourses.begin() + studentOffsets[row], studentCourses.begin() + studentOffsets[row + 1]);
+        }
+        // Walking students in id order leaves every roster already sorted by student id.
+        vector<uint32_t> byId(rows);
+        for (uint32_t row = 0; row < rows; ++row) {
+            byId[row] = row;
+        }
+        sort(byId.begin(), byId.end(), [this](uint32_t a, uint32_t b) { return studentIds[a] < studentIds[b]; });
+        courseStudents.resize(edges.size());
+        fill.assign(courseOffsets.begin(), courseOffsets.end() - 1);
+        for (uint32_t row : byId) {
+            for (uint32_t at = studentOffsets[row]; at < studentOffsets[row + 1]; ++at) {
+                courseStudents[fill[studentCourses[at]]++] = row;
+            }
+        }
+        builtEdges = edges.size();
+        pending.clear();
     }
 
-    void addCourse(const Course& course) {
-        enrolledCourses.push_back(course);
-        attendance[course.getCourseCode()] = 0; 
-        examScores[course.getCourseCode()] = {}; 
+    void ensureBuilt() const {
+        if (builtEdges != edges.size()) {
+            rebuild();
+        }
     }
 
-    void updateAttendance(string courseCode, int newAttendance) {
-        attendance[courseCode] = newAttendance;
+    bool containsLocked(int studentId, CourseId course) const {
+        auto it = studentRows.find(studentId);
+        if (it == studentRows.end()) {
+            return false;
+        }
+        uint32_t row = it->second;
+        if (row + 1 < studentOffsets.size()
+            && binary_search(studentCourses.begin() + studentOffsets[row], studentCourses.begin() + studentOffsets[row + 1], course)) {
+            return true;
+        }
+        return pending.count(key(studentId, course)) > 0;
     }
 
-    void recordExamScore(string courseCode, string examType, float score) {
-        examScores[courseCode][examType] = score;
+    vector<int> rosterLocked(CourseId course) const {
+        vector<int> roster;
+        if (course + 1 < courseOffsets.size()) {
+            roster.reserve(courseOffsets[course + 1] - courseOffsets[course]);
+            for (uint32_t at = courseOffsets[course]; at < courseOffsets[course + 1]; ++at) {
+                roster.push_back(studentIds[courseStudents[at]]);
+            }
+        }
+        return roster;
     }
 
-    void viewExamScores() const {
-        if (examScores.empty()) {
-            cout << "No exam scores recorded.\n";
-            return;
+public:
+    EnrollmentIndex() : builtEdges(0) {}
+
+    bool enroll(int studentId, CourseId course) {
+        lock_guard<mutex> guard(indexLock);
+        if (containsLocked(studentId, course)) {
+            return false;
         }
-        cout << "Exam Scores:\n";
-        for (const auto& course : examScores) {
-            cout << "Course: " << course.first << "\n ";
-            for ( const auto& exam : course.second) {
-                cout << "  Exam: " << exam.first << " | Score: " << exam.second << "\n";
-            }
+        auto row = studentRows.emplace(studentId, uint32_t(studentIds.size()));
+        if (row.second) {
+            studentIds.push_back(studentId);
+        }
+        if (course >= headcounts.size()) {
+            headcounts.resize(course + 1, 0);
+            teachers.resize(course + 1);
+        }
+        edges.emplace_back(row.first->second, course);
+        ++headcounts[course];
+        pending.insert(key(studentId, course));
+        if (pending.size() > max(MIN_PENDING, builtEdges / 2)) {
+            rebuild();
         }
+        return true;
     }
 
-    void viewAttendance() const {
-        if (attendance.empty()) {
-            cout << "No attendance recorded.\n";
-            return;
+    void teach(const string& faculty, CourseId course) {
+        lock_guard<mutex> guard(indexLock);
+        auto row = facultyRows.emplace(faculty, uint32_t(facultyNames.size()));
+        if (row.second) {
+            facultyNames.push_back(faculty);
+            taught.emplace_back();
         }
-        cout << "Attendance Report:\n";
-        for (const auto& entry : attendance) {
-            cout << "Course: " << entry.first << " | Attendance: " << entry.second << "%\n";
+        if (course >= headcounts.size()) {
+            headcounts.resize(course + 1, 0);
+            teachers.resize(course + 1);
+        }
+        vector<CourseId>& courses = taught[row.first->second];
+        if (find(courses.begin(), courses.end(), course) == courses.end()) {
+            courses.push_back(course);
+            teachers[course].push_back(row.first->second);
         }
     }
 
-    void viewGrades() const {
-        cout << "Final Grade: " << finalGrade << "\n";
+    bool contains(int studentId, CourseId course) const {
+        lock_guard<mutex> guard(indexLock);
+        return containsLocked(studentId, course);
     }
 
-    void displayEnrolledCourses() const {
-        if (enrolledCourses.empty()) {
-            cout << "No courses enrolled.\n";
+    void splitEnrolled(CourseId course, const vector<int>& candidates, vector<int>& enrolled, vector<int>& rejected) const {
+        lock_guard<mutex> guard(indexLock);
+        enrolled.reserve(enrolled.size() + candidates.size());
+        if (builtEdges != edges.size() || course + 1 >= courseOffsets.size() || !is_sorted(candidates.begin(), candidates.end())) {
+            for (int studentId : candidates) {
+                (containsLocked(studentId, course) ? enrolled : rejected).push_back(studentId);
+            }
             return;
         }
-        cout << "Enrolled Courses:\n";
-        for (const auto& course : enrolledCourses) {
-            course.displayCourse();
+        // A sorted list against a built roster is a single merge.
+        uint32_t at = courseOffsets[course], end = courseOffsets[course + 1];
+        for (int studentId : candidates) {
+            while (at < end && studentIds[courseStudents[at]] < studentId) {
+                ++at;
+            }
+            (at < end && studentIds[courseStudents[at]] == studentId ? enrolled : rejected).push_back(studentId);
         }
     }
 
-    void viewFees() const {
-        feeInfo->viewFees();
+    uint32_t headcount(CourseId course) const {
+        lock_guard<mutex> guard(indexLock);
+        return course < headcounts.size() ? headcounts[course] : 0;
     }
 
-    void makePayment(float amount) {
-        feeInfo->makePayment(amount);
+    vector<int> roster(CourseId course) const {
+        lock_guard<mutex> guard(indexLock);
+        ensureBuilt();
+        return rosterLocked(course);
     }
 
-    void menu() override {
-        int choice;
-        do {
-            cout << "\nStudent Menu\n";
-            cout << "1. Add Course\n";
-            cout << "2. View Enrolled Courses\n";
-            cout << "3. View Grades\n";
-            cout << "4. View Attendance\n";
-            cout << "5. View Exam Scores\n";
-            cout << "6. View Fees\n";
-            cout << "7. Make Payment\n";
-            cout << "8. Logout\n";
-            cout << "Enter your choice: ";
-            cin >> choice;
+    vector<CourseId> coursesOf(int studentId) const {
+        lock_guard<mutex> guard(indexLock);
+        ensureBuilt();
+        auto it = studentRows.find(studentId);
+        if (it == studentRows.end()) {
+            return {};
+        }
+        return vector<CourseId>(studentCourses.begin() + studentOffsets[it->second], studentCourses.begin() + studentOffsets[it->second + 1]);
+    }
 
-            switch (choice) {
-                case 1: {
-                    string courseCode, courseName;
-                    cout << "Enter Course Code: ";
-                    cin >> courseCode;
-                    cin.ignore();
-                    cout << "Enter Course Name: ";
-                    getline(cin, courseName);
-                    addCourse(Course(courseCode, courseName));
-                    cout << "Course added successfully!\n";
-                    break;
-                }
-                case 2:
-                    displayEnrolledCourses();
-                    break;
-                case 3:
-                    viewGrades();
-                    break;
-                case 4:
-                    viewAttendance();
-                    break;
-                case 5:
-                    viewExamScores();
-                    break;
-                case 6:
-                    viewFees();
-                    break;
-                case 7: {
-                    float paymentAmount;
-                    cout << "Enter payment amount: ";
-                    cin >> paymentAmount;
-                    makePayment(paymentAmount);
-                    break;
-                }
-                case 8:
-                    cout << "Logging out...\n";
-                    break;
-                default:
-                    cout << "Invalid choice! Please try again.\n";
+    vector<string> facultyOf(int studentId) const {
+        lock_guard<mutex> guard(indexLock);
+        ensureBuilt();
+        vector<string> names;
+        auto it = studentRows.find(studentId);
+        if (it == studentRows.end()) {
+            return names;
+        }
+        for (uint32_t at = studentOffsets[it->second]; at < studentOffsets[it->second + 1]; ++at) {
+            for (uint32_t faculty : teachers[studentCourses[at]]) {
+                names.push_back(facultyNames[faculty]);
             }
-        } while (choice != 8);
+        }
+        sort(names.begin(), names.end());
+        names.erase(unique(names.begin(), names.end()), names.end());
+        return names;
+    }
+
+    vector<int> studentsOf(const string& faculty) const {
+        lock_guard<mutex> guard(indexLock);
+        ensureBuilt();
+        vector<int> students;
+        auto it = facultyRows.find(faculty);
+        if (it == facultyRows.end()) {
+            return students;
+        }
+        for (CourseId course : taught[it->second]) {
+            vector<int> roster = rosterLocked(course);
+            students.insert(students.end(), roster.begin(), roster.end());
+        }
+        sort(students.begin(), students.end());
+        students.erase(unique(students.begin(), students.end()), students.end());
+        return students;
+    }
+
+    size_t heapBytes() const {
+        lock_guard<mutex> guard(indexLock);
+        size_t bytes = studentIds.capacity() * sizeof(int) + edges.capacity() * sizeof(pair<uint32_t, CourseId>)
+                     + headcounts.capacity() * sizeof(uint32_t) + studentOffsets.capacity() * sizeof(uint32_t)
+                     + studentCourses.capacity() * sizeof(CourseId) + courseOffsets.capacity() * sizeof(uint32_t)
+                     + courseStudents.capacity() * sizeof(uint32_t);
+        bytes += studentRows.size() * (sizeof(pair<const int, uint32_t>) + sizeof(void*)) + studentRows.bucket_count() * sizeof(void*);
+        bytes += pending.size() * (sizeof(uint64_t) + sizeof(void*)) + pending.bucket_count() * sizeof(void*);
+        return bytes;
     }
 };
 
-class Faculty : public User {
+class TimestampFormatter {
 private:
-    vector<Course> assignedCourses;
-    map<int, map<string, int>> studentAttendance; 
-    map<int, map<string, map<string, float>>> studentExamScores; 
-    map<int, map<string, float>> studentFinalGrades; 
+    static const size_t HOUR_SLOTS = 64;
 
-public:
-    Faculty(string u, string p) : User(u, p, "faculty") {}
+    // Instants in [from, until) share the local hour that began at start; near an offset change the range is cut short.
+    struct HourEntry {
+        time_t start = -1;
+        time_t from = -1;
+        time_t until = -1;
+        char prefix[16];
+    };
 
-    void assignCourse(const Course& course) {
-        assignedCourses.push_back(course);
+    struct Cache {
+        time_t lastSecond = -1;
+        char lastText[20];
+        HourEntry hours[HOUR_SLOTS];
+    };
+
+    static Cache& cache() {
+        thread_local Cache perThread;
+        return perThread;
     }
 
-    void recordAttendance(int studentId, string courseCode, int attendance) {
-        studentAttendance[studentId][courseCode] = attendance;
-        cout << "Attendance recorded for Student ID: " << studentId << " in Course: " << courseCode << ".\n";
+    static bool toLocal(time_t t, struct tm& out) {
+#ifdef _WIN32
+        return localtime_s(&out, &t) == 0;
+#else
+        return localtime_r(&t, &out) != nullptr;
+#endif
     }
 
-    void recordExamScore(int studentId, string courseCode, string examType, float score) {
-        studentExamScores[studentId][courseCode][examType] = score;
-        cout << "Exam score recorded for Student ID: " << studentId << " in Course: " << courseCode << " for " << examType << " exam.\n";
+    static bool sameHour(const HourEntry& hour, time_t t) {
+        struct tm local;
+        char prefix[16];
+        if (!toLocal(t, local)) {
+            return false;
+        }
+        strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:", &local);
+        return strcmp(prefix, hour.prefix) == 0 && local.tm_min * 60 + local.tm_sec == t - hour.start;
     }
 
-    void assignFinalGrade(int studentId, string courseCode, float grade) {
-        studentFinalGrades[studentId][courseCode] = grade;
-        cout << "Final grade assigned for Student ID: " << studentId << " in Course: " << courseCode << ".\n";
+    static void putTwoDigits(char* out, int value) {
+        out[0] = char('0' + value / 10);
+        out[1] = char('0' + value % 10);
     }
 
-    void viewStudentAttendance() const {
-        if (studentAttendance.empty()) {
-            cout << "No attendance records available.\n";
+public:
+    static const size_t LENGTH = 19;
+
+    static void format(time_t t, char* out) {
+        Cache& c = cache();
+        if (t == c.lastSecond) {
+            memcpy(out, c.lastText, LENGTH + 1);
             return;
         }
-        cout << "Attendance Records for Assigned Courses:\n";
-        for (const auto& studentEntry : studentAttendance) {
-            cout << "Student ID: " << studentEntry.first << "\n";
-            for (const auto& courseEntry : studentEntry.second) {
-                cout << "  Course: " << courseEntry.first << " | Attendance: " << courseEntry.second << "%\n";
+        HourEntry& hour = c.hours[size_t(t / 3600) % HOUR_SLOTS];
+        if (hour.start < 0 || t < hour.from || t >= hour.until) {
+            struct tm local;
+            if (!toLocal(t, local)) {
+                strcpy(out, "0000-00-00 00:00:00");
+                return;
             }
+            strftime(hour.prefix, sizeof(hour.prefix), "%Y-%m-%d %H:", &local);
+            hour.start = t - (local.tm_min * 60 + local.tm_sec);
+            // A DST shift inside the hour (30 minutes in some zones) gives part of it another offset.
+            hour.from = sameHour(hour, hour.start) ? hour.start : t;
+            hour.until = sameHour(hour, hour.start + 3599) ? hour.start + 3600 : t + 1;
         }
+        int offset = int(t - hour.start);
+        memcpy(out, hour.prefix, 14);
+        putTwoDigits(out + 14, offset / 60);
+        out[16] = ':';
+        putTwoDigits(out + 17, offset % 60);
+        out[LENGTH] = '\0';
+        c.lastSecond = t;
+        memcpy(c.lastText, out, LENGTH + 1);
     }
 
-    void viewStudentExamScores() const {
-        if (studentExamScores.empty()) {
-            cout << "No exam scores recorded.\n";
-            return;
-        }
-        cout << "Exam Scores for Assigned Courses:\n";
-        for (const auto& studentEntry : studentExamScores) {
-            cout << "Student ID: " << studentEntry.first << "\n";
-            for (const auto& courseEntry : studentEntry.second) {
-                cout << "  Course: " << courseEntry.first << "\n";
-                for (const auto& examEntry : courseEntry.second) {
-                    cout << "    Exam: " << examEntry.first << " | Score: " << examEntry.second << "\n";
-                }
-            }
-        }
+    static string format(time_t t) {
+        char buffer[LENGTH + 1];
+        format(t, buffer);
+        return string(buffer, LENGTH);
     }
+};
 
-    void viewStudentFinalGrades() const {
-        if (studentFinalGrades.empty()) {
-            cout << "No final grades assigned.\n";
-            return;
+typedef int64_t Cents;
+
+// Accepts "1234", "1234.5" or "1234.567"; extra decimal places round half up to the cent.
+inline bool parseMoney(const string& text, Cents& out) {
+    const Cents limit = Cents(1) << 50;
+    Cents whole = 0, fraction = 0;
+    bool digits = false;
+    size_t i = 0;
+    for (; i < text.size() && isdigit(static_cast<unsigned char>(text[i])); ++i) {
+        whole = whole * 10 + (text[i] - '0');
+        digits = true;
+        if (whole > limit) {
+            return false;
         }
-        cout << "Final Grades for Assigned Courses:\n";
-        for (const auto& studentEntry : studentFinalGrades) {
-            cout << "Student ID: " << studentEntry.first << "\n";
-            for (const auto& courseEntry : studentEntry.second) {
-                cout << "  Course: " << courseEntry.first << " | Final Grade: " << courseEntry.second << "\n";
+    }
+    if (i < text.size() && text[i] == '.') {
+        int places = 0;
+        for (++i; i < text.size() && isdigit(static_cast<unsigned char>(text[i])); ++i, ++places) {
+            digits = true;
+            if (places < 2) {
+                fraction = fraction * 10 + (text[i] - '0');
+            } else if (places == 2 && text[i] >= '5') {
+                fraction += 1;
             }
         }
+        if (places == 1) {
+            fraction *= 10;
+        }
     }
-
-    void menu() override {
-        int choice;
-        do {
-            cout << "\nFaculty Menu\n";
-            cout << "1. Assign Course\n";
-            cout << "2. Record Attendance\n";
-            cout << "3. Record Exam Score\n";
-            cout << "4. Assign Final Grade\n";
-            cout << "5. View Student Attendance\n";
-            cout << "6. View Student Exam Scores\n";
-            cout << "7. View Student Final Grades\n";
-            cout << "8. Logout\n";
-            cout << "Enter your choice: ";
-            cin >> choice;
-
-            switch (choice) {
-                case 1: {
-                    string courseCode, courseName;
-                    cout << "Enter Course Code: ";
-                    cin >> courseCode;
-                    cin.ignore();
-                    cout << "Enter Course Name: ";
-                    getline(cin, courseName);
-                    assignCourse(Course(courseCode, courseName));
-                    cout << "Course assigned successfully!\n";
-                    break;
-                }
-                case 2: {
-                    int studentId;
-                    string courseCode;
-                    int attendance;
-                    cout << "Enter Student ID: ";
-                    cin >> studentId;
-                    cout << "Enter Course Code: ";
-                    cin >> courseCode;
-                    cout << "Enter Attendance: ";
-                    cin >> attendance;
-                    recordAttendance(studentId, courseCode, attendance);
-                    break;
-                }
-                case 3: {
-                    int studentId;
-                    string courseCode, examType;
-                    float score;
-                    cout << "Enter Student ID: ";
-                    cin >> studentId;
-                    cout << "Enter Course Code: ";
-                    cin >> courseCode;
-                    cout << "Enter Exam Type: ";
-                    cin >> examType;
-                    cout << "Enter Score: ";
-                    cin >> score;
-                    recordExamScore(studentId, courseCode, examType, score);
-                    break;
-                }
-                case 4: {
-                    int studentId;
-                    string courseCode;
-                    float grade;
-                    cout << "Enter Student ID: ";
-                    cin >> studentId;
-                    cout << "Enter Course Code: ";
-                    cin >> courseCode;
-                    cout << "Enter Final Grade: ";
-                    cin >> grade;
-                    assignFinalGrade(studentId, courseCode, grade);
-                    break;
-                }
-                case 5:
-                    viewStudentAttendance();
-                    break;
-                case 6:
-                    viewStudentExamScores();
-                    break;
-                case 7:
-                    viewStudentFinalGrades();
-                    break;
-                case 8:
-                    cout << "Logging out...\n";
-                    break;
-                default:
-                    cout << "Invalid choice! Please try again.\n";
-            }
-        } while (choice != 8);
+    if (!digits || i != text.size()) {
+        return false;
     }
-};
+    out = whole * 100 + fraction;
+    return true;
+}
 
-class Notice {
+inline string formatMoney(Cents amount) {
+    Cents magnitude = amount < 0 ? -amount : amount;
+    string text = amount < 0 ? "-" : "";
+    text += to_string(magnitude / 100);
+    text += '.';
+    text += char('0' + magnitude % 100 / 10);
+    text += char('0' + magnitude % 10);
+    return text;
+}
+
+class FeeLedger {
 public:
-    int id;
-    string message;
-    string category;
-    time_t timestamp;
+    enum class EntryKind : uint8_t { Charge, Payment };
+    enum class PostStatus { Posted, UnknownStudent, InvalidAmount, ExceedsDue };
 
-    Notice(int noticeId, const string& msg, const string& cat)
-        : id(noticeId), message(msg), category(cat), timestamp(time(0)) {}
+    struct Entry {
+        int32_t studentId;
+        uint32_t previous;
+        Cents amount;
+        int64_t posted;
+        uint32_t batch;
+        EntryKind kind;
+    };
 
-    string getTimestamp() const {
-        char buffer[80];
-        struct tm* timeinfo = localtime(&timestamp);
-        strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
-        return string(buffer);
-    }
-};
+    struct Payment {
+        int studentId;
+        Cents amount;
+    };
+
+    struct BatchResult {
+        uint32_t batch;
+        size_t posted;
+        Cents total;
+    };
 
-class NoticeBoard {
 private:
-    vector<Notice> notices;
-    int nextNoticeId;
+    static const uint32_t NONE = UINT32_MAX;
 
-public:
-    NoticeBoard() : nextNoticeId(1) {}
+    struct Account {
+        Cents charged;
+        Cents paid;
+        uint32_t last;
+        uint32_t duePosition;
 
-    void addNotice(const string& message, const string& category) {
-        notices.push_back(Notice (nextNoticeId++, message, category));
-        cout << "Notice added successfully!\n";
-    }
+        Cents due() const { return charged > paid ? charged - paid : 0; }
+    };
 
-    void editNotice(int id, const string& newMessage) {
-        for (auto& notice : notices) {
-            if (notice.id == id) {
-                notice.message = newMessage;
-                cout << "Notice updated successfully!\n";
-                return;
-            }
+    unordered_map<int, Account> accounts;
+    vector<Entry> entries;
+    vector<int> dueStudents;
+    Cents outstanding;
+    uint32_t lastBatch;
+    WriteAheadLog* journal;
+    mutable mutex ledgerLock;
+
+    void append(int studentId, Account& account, EntryKind kind, Cents amount, time_t posted, uint32_t batch) {
+        entries.push_back({studentId, account.last, amount, int64_t(posted), batch, kind});
+        account.last = uint32_t(entries.size() - 1);
+        Cents before = account.due();
+        if (kind == EntryKind::Charge) {
+            account.charged += amount;
+        } else {
+            account.paid += amount;
         }
-        cout << "Notice not found!\n";
+        outstanding += account.due() - before;
+        trackDues(studentId, account);
     }
 
-    void deleteNotice(int id) {
-        for (auto it = notices.begin(); it != notices.end(); ++it) {
-            if (it->id == id) {
-                notices.erase(it);
-                cout << "Notice deleted successfully!\n";
-                return;
-            }
+    // Keeps dueStudents equal to the set of accounts with a balance, so listing dues never scans every account.
+    void trackDues(int studentId, Account& account) {
+        bool owes = account.due() > 0;
+        if (owes && account.duePosition == NONE) {
+            account.duePosition = uint32_t(dueStudents.size());
+            dueStudents.push_back(studentId);
+        } else if (!owes && account.duePosition != NONE) {
+            int moved = dueStudents.back();
+            dueStudents[account.duePosition] = moved;
+            accounts[moved].duePosition = account.duePosition;
+            dueStudents.pop_back();
+            account.duePosition = NONE;
         }
-        cout << "Notice not found!\n";
     }
 
-    void viewNotices() const {
-        if (notices.empty()) {
-            cout << "No notices available.\n";
-            return;
+    PostStatus check(unordered_map<int, Account>::iterator it, Cents amount) const {
+        if (it == accounts.end()) {
+            return PostStatus::UnknownStudent;
         }
-        cout << "Notice Board:\n";
-        for (const auto& notice : notices) {
-            cout << "Notice ID: " << notice.id << "\n";
-            cout << "Message: " << notice.message << "\n";
-            cout << "Category: " << notice.category << "\n";
-            cout << "Timestamp: " << notice.getTimestamp() << "\n";
-            cout << "-------------------------\n";
+        if (amount <= 0) {
+            return PostStatus::InvalidAmount;
         }
+        return it->second.paid + amount <= it->second.charged ? PostStatus::Posted : PostStatus::ExceedsDue;
     }
-};
-
-class Library {
-private:
-    vector<string> books;
 
 public:
-    void addBook(const string& book) {
-        books.push_back(book);
-        cout << "Book added successfully!\n";
+    FeeLedger() : outstanding(0), lastBatch(0), journal(nullptr) {}
+
+    void setJournal(WriteAheadLog* log) { journal = log; }
+
+    // One reconciliation line: student_id,amount[,bank reference]
+    static bool parsePayment(const string& line, Payment& payment) {
+        size_t comma = line.find(',');
+        if (comma == string::npos) {
+            return false;
+        }
+        size_t next = line.find(',', comma + 1);
+        string id = line.substr(0, comma);
+        char* end = nullptr;
+        long parsed = strtol(id.c_str(), &end, 10);
+        if (id.empty() || *end != '\0' || parsed < INT32_MIN || parsed > INT32_MAX) {
+            return false;
+        }
+        payment.studentId = int(parsed);
+        return parseMoney(line.substr(comma + 1, next == string::npos ? string::npos : next - comma - 1), payment.amount);
     }
 
-    void removeBook(const string& book) {
-        for (auto it = books.begin(); it != books.end(); ++it) {
-            if (*it == book) {
-                books.erase(it);
-                cout << "Book removed successfully!\n";
-                return;
-            }
+    bool openAccount(int studentId, Cents fee) {
+        lock_guard<mutex> guard(ledgerLock);
+        auto inserted = accounts.emplace(studentId, Account{0, 0, NONE, NONE});
+        if (!inserted.second) {
+            return false;
         }
-        cout << "Book not found!\n";
+        if (fee > 0) {
+            append(studentId, inserted.first->second, EntryKind::Charge, fee, 0, 0);
+        }
+        return true;
     }
 
-    void checkOutBook(const string& book, const string& borrower) {
-        for (auto it = books.begin(); it != books.end(); ++it) {
-            if (*it == book) {
-                cout << "Book checked out to " << borrower << " successfully!\n";
-                books.erase(it);
-                return;
+    PostStatus post(int studentId, Cents amount) {
+        lock_guard<mutex> guard(ledgerLock);
+        auto it = accounts.find(studentId);
+        PostStatus status = check(it, amount);
+        if (status == PostStatus::Posted) {
+            time_t now = time(0);
+            append(studentId, it->second, EntryKind::Payment, amount, now, 0);
+            if (journal) {
+                journal->append({"fee-pay", to_string(studentId), to_string(amount), to_string(now), "0"});
             }
         }
-        cout << "Book not found!\n";
+        return status;
     }
 
-    void returnBook(const string& book, const string& borrower) {
-        books.push_back(book);
-        cout << "Book returned by " << borrower << " successfully!\n";
+    // Posts a whole reconciliation file under one lock and one journal record; statuses[i] reports payments[i].
+    BatchResult postBatch(const vector<Payment>& payments, vector<PostStatus>& statuses) {
+        lock_guard<mutex> guard(ledgerLock);
+        BatchResult result = {++lastBatch, 0, 0};
+        time_t now = time(0);
+        statuses.resize(payments.size());
+        vector<string> record;
+        if (journal) {
+            record = {"fee-batch", to_string(result.batch), to_string(now)};
+            record.reserve(3 + 2 * payments.size());
+        }
+        for (size_t i = 0; i < payments.size(); ++i) {
+            const Payment& payment = payments[i];
+            auto it = accounts.find(payment.studentId);
+            statuses[i] = check(it, payment.amount);
+            if (statuses[i] != PostStatus::Posted) {
+                continue;
+            }
+            append(payment.studentId, it->second, EntryKind::Payment, payment.amount, now, result.batch);
+            ++result.posted;
+            result.total += payment.amount;
+            if (journal) {
+                record.push_back(to_string(payment.studentId));
+                record.push_back(to_string(payment.amount));
+            }
+        }
+        if (journal && result.posted > 0) {
+            journal->append(record);
+        }
+        return result;
     }
 
-    void viewBooks() const {
-        if (books.empty()) {
-            cout << "No books available.\n";
+    // Replays a payment that was validated when it was first posted.
+    void restorePayment(int studentId, Cents amount, time_t posted, uint32_t batch) {
+        lock_guard<mutex> guard(ledgerLock);
+        auto it = accounts.find(studentId);
+        if (it == accounts.end()) {
             return;
         }
-        cout << "Available Books:\n";
-        for (const auto& book : books) {
-            cout << book << "\n";
-        }
+        append(studentId, it->second, EntryKind::Payment, amount, posted, batch);
+        lastBatch = max(lastBatch, batch);
     }
-};
 
-class Hostel {
-private:
-    vector<string> rooms;
-    map<string, string> roomAssignments;
-
-public:
-    void addRoom(const string& room) {
-        rooms.push_back(room);
-        cout << "Room added successfully!\n";
+    bool balance(int studentId, Cents& charged, Cents& paid) const {
+        lock_guard<mutex> guard(ledgerLock);
+        auto it = accounts.find(studentId);
+        if (it == accounts.end()) {
+            return false;
+        }
+        charged = it->second.charged;
+        paid = it->second.paid;
+        return true;
     }
 
-    void assignRoom(const string& room, const string& student) {
-        if (find(rooms.begin(), rooms.end(), room) != rooms.end()) {
-            roomAssignments[room] = student;
-            cout << "Room assigned to " << student << " successfully!\n";
-        } else {
-            cout << "Room not found!\n";
+    vector<Entry> history(int studentId) const {
+        lock_guard<mutex> guard(ledgerLock);
+        vector<Entry> list;
+        auto it = accounts.find(studentId);
+        for (uint32_t at = it == accounts.end() ? NONE : it->second.last; at != NONE; at = entries[at].previous) {
+            list.push_back(entries[at]);
         }
+        reverse(list.begin(), list.end());
+        return list;
     }
 
-    void viewRooms() const {
-        if (rooms.empty()) {
-            cout << "No rooms available.\n";
-            return;
-        }
-        cout << "Available Rooms:\n";
-        for (const auto& room : rooms) {
-            cout << room << "\n";
+    // Largest balances first.
+    vector<pair<int, Cents>> studentsWithDues() const {
+        lock_guard<mutex> guard(ledgerLock);
+        vector<pair<int, Cents>> list;
+        list.reserve(dueStudents.size());
+        for (int studentId : dueStudents) {
+            list.emplace_back(studentId, accounts.at(studentId).due());
         }
+        sort(list.begin(), list.end(), [](const pair<int, Cents>& a, const pair<int, Cents>& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        return list;
     }
 
-    void viewRoomAssignments() const {
-        if (roomAssignments.empty()) {
-            cout << "No room assignments available.\n";
-            return;
+    void outstandingSummary(size_t& students, Cents& total) const {
+        lock_guard<mutex> guard(ledgerLock);
+        students = dueStudents.size();
+        total = outstanding;
+    }
+
+    // Recounts balances from the entry chains and checks them against the running totals.
+    bool verifyTotals(vector<string>& problems) const {
+        lock_guard<mutex> guard(ledgerLock);
+        size_t before = problems.size(), owing = 0;
+        Cents total = 0;
+        for (const auto& entry : accounts) {
+            const Account& account = entry.second;
+            Cents charged = 0, paid = 0;
+            for (uint32_t at = account.last; at != NONE; at = entries[at].previous) {
+                (entries[at].kind == EntryKind::Charge ? charged : paid) += entries[at].amount;
+            }
+            if (charged != account.charged || paid != account.paid) {
+                problems.push_back("fee account " + to_string(entry.first) + " differs from its ledger entries");
+            }
+            bool listed = account.duePosition < dueStudents.size() && dueStudents[account.duePosition] == entry.first;
+            if ((account.due() > 0) != listed) {
+                problems.push_back("fee account " + to_string(entry.first) + " is misfiled in the dues list");
+            }
+            owing += account.due() > 0;
+            total += account.due();
+        }
+        if (owing != dueStudents.size()) {
+            problems.push_back("dues list holds " + to_string(dueStudents.size()) + " students, a recount finds " + to_string(owing));
         }
-        cout << "Room Assignments:\n";
-        for (const auto& assignment : roomAssignments) {
-            cout << "Room: " << assignment.first << ", Student: " << assignment.second << "\n";
+        if (total != outstanding) {
+            problems.push_back("outstanding total is $" + formatMoney(outstanding) + ", a recount finds $" + formatMoney(total));
         }
+        return problems.size() == before;
     }
-};
 
-class Event {
-public:
-    int id;
-    string name;
-    string description;
-    string date;
-    string time;
-    string location;
+    size_t recordCount() const {
+        lock_guard<mutex> guard(ledgerLock);
+        return entries.size();
+    }
 
-    Event(int eventId, const string& name, const string& description, const string& date, const string& time, const string& location) 
-        : id(eventId), name(name), description(description), date(date), time(time), location(location) {}
+    size_t heapBytes() const {
+        lock_guard<mutex> guard(ledgerLock);
+        return entries.capacity() * sizeof(Entry) + dueStudents.capacity() * sizeof(int)
+             + accounts.size() * (sizeof(pair<const int, Account>) + 2 * sizeof(void*)) + accounts.bucket_count() * sizeof(void*);
+    }
 
-    void displayEvent() const {
-        cout << "Event ID: " << id << "\n";
-        cout << "Event Name: " << name << "\n";
-        cout << "Event Description: " << description << "\n";
-        cout << "Event Date: " << date << "\n";
-        cout << "Event Time: " << time << "\n";
-        cout << "Event Location: " << location << "\n";
+    void writeState(ostream& out) const {
+        lock_guard<mutex> guard(ledgerLock);
+        for (const auto& entry : entries) {
+            if (entry.kind == EntryKind::Payment) {
+                WriteAheadLog::writeRecord(out, {"fee-pay", to_string(entry.studentId), to_string(entry.amount), to_string(entry.posted), to_string(entry.batch)});
+            }
+        }
     }
 };
 
-class EventManagementSystem {
+struct ScoreSummary {
+    static const int BUCKETS = 10;
+
+    size_t count;
+    double mean;
+    double stddev;
+    float min;
+    float max;
+    double passRate;
+    size_t buckets[BUCKETS];
+};
+
+class GradeStatistics {
 private:
-    vector<Event> events;
-    int nextEventId;
+    static int bucketOf(float score) {
+        int bucket = int(score / 10.0f);
+        return bucket < 0 ? 0 : (bucket >= ScoreSummary::BUCKETS ? ScoreSummary::BUCKETS - 1 : bucket);
+    }
 
 public:
-    EventManagementSystem() : nextEventId(1) {}
-
-    void addEvent(const string& name, const string& description, const string& date, const string& time, const string& location) {
-        events.push_back(Event(nextEventId++, name, description, date, time, location));
-        cout << "Event added successfully!\n";
+    static const char* kernel() {
+#if defined(__AVX2__)
+        return "AVX2";
+#elif defined(__SSE2__)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
     }
 
-    void editEvent(int id, const string& newName, const string& newDescription, const string& newDate, const string& newTime, const string& newLocation) {
-        for (auto& event : events) {
-            if (event.id == id) {
-                event.name = newName;
-                event.description = newDescription;
-                event.date = newDate;
-                event.time = newTime;
-                event.location = newLocation;
-                cout << "Event updated successfully!\n";
-                return;
+    static ScoreSummary summarize(const float* scores, size_t n, float passMark) {
+        ScoreSummary summary = {};
+        summary.count = n;
+        if (n == 0) {
+            return summary;
+        }
+        double sum = 0.0, sumSquares = 0.0;
+        float low = scores[0], high = scores[0];
+        size_t passed = 0;
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m256d sumLo = _mm256_setzero_pd(), sumHi = _mm256_setzero_pd();
+        __m256d sqLo = _mm256_setzero_pd(), sqHi = _mm256_setzero_pd();
+        __m256 minV = _mm256_set1_ps(low), maxV = _mm256_set1_ps(high);
+        __m256 passV = _mm256_set1_ps(passMark);
+        __m256 scale = _mm256_set1_ps(0.1f);
+        __m256i lastBucket = _mm256_set1_epi32(ScoreSummary::BUCKETS - 1);
+        __m256i bucketCounts[ScoreSummary::BUCKETS];
+        for (int b = 0; b < ScoreSummary::BUCKETS; ++b) {
+            bucketCounts[b] = _mm256_setzero_si256();
+        }
+        for (; i + 8 <= n; i += 8) {
+            __m256 v = _mm256_loadu_ps(scores + i);
+            __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+            __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+            sumLo = _mm256_add_pd(sumLo, lo);
+            sumHi = _mm256_add_pd(sumHi, hi);
+            sqLo = _mm256_add_pd(sqLo, _mm256_mul_pd(lo, lo));
+            sqHi = _mm256_add_pd(sqHi, _mm256_mul_pd(hi, hi));
+            minV = _mm256_min_ps(minV, v);
+            maxV = _mm256_max_ps(maxV, v);
+            passed += __builtin_popcount(_mm256_movemask_ps(_mm256_cmp_ps(v, passV, _CMP_GE_OQ)));
+            __m256i ids = _mm256_cvttps_epi32(_mm256_mul_ps(v, scale));
+            ids = _mm256_min_epi32(_mm256_max_epi32(ids, _mm256_setzero_si256()), lastBucket);
+            for (int b = 0; b < ScoreSummary::BUCKETS; ++b) {
+                bucketCounts[b] = _mm256_sub_epi32(bucketCounts[b], _mm256_cmpeq_epi32(ids, _mm256_set1_epi32(b)));
             }
         }
-        cout << "Event not found!\n";
-    }
-
-    void deleteEvent(int id) {
-        for (auto it = events.begin(); it != events.end(); ++it) {
-            if (it->id == id) {
-                events.erase(it);
-                cout << "Event deleted successfully!\n";
-                return;
+        alignas(32) uint32_t laneCounts[8];
+        for (int b = 0; b < ScoreSummary::BUCKETS; ++b) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(laneCounts), bucketCounts[b]);
+            for (int lane = 0; lane < 8; ++lane) {
+                summary.buckets[b] += laneCounts[lane];
+            }
+        }
+        alignas(32) double lanes[4];
+        alignas(32) float floatLanes[8];
+        _mm256_store_pd(lanes, _mm256_add_pd(sumLo, sumHi));
+        sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        _mm256_store_pd(lanes, _mm256_add_pd(sqLo, sqHi));
+        sumSquares = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        _mm256_store_ps(floatLanes, minV);
+        low = *min_element(floatLanes, floatLanes + 8);
+        _mm256_store_ps(floatLanes, maxV);
+        high = *max_element(floatLanes, floatLanes + 8);
+#elif defined(__SSE2__)
+        __m128d sumLo = _mm_setzero_pd(), sumHi = _mm_setzero_pd();
+        __m128d sqLo = _mm_setzero_pd(), sqHi = _mm_setzero_pd();
+        __m128 minV = _mm_set1_ps(low), maxV = _mm_set1_ps(high);
+        __m128 passV = _mm_set1_ps(passMark);
+        __m128 scale = _mm_set1_ps(0.1f);
+        __m128 lastBucket = _mm_set1_ps(float(ScoreSummary::BUCKETS - 1));
+        __m128i bucketCounts[ScoreSummary::BUCKETS];
+        for (int b = 0; b < ScoreSummary::BUCKETS; ++b) {
+            bucketCounts[b] = _mm_setzero_si128();
+        }
+        for (; i + 4 <= n; i += 4) {
+            __m128 v = _mm_loadu_ps(scores + i);
+            __m128d lo = _mm_cvtps_pd(v);
+            __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+            sumLo = _mm_add_pd(sumLo, lo);
+            sumHi = _mm_add_pd(sumHi, hi);
+            sqLo = _mm_add_pd(sqLo, _mm_mul_pd(lo, lo));
+            sqHi = _mm_add_pd(sqHi, _mm_mul_pd(hi, hi));
+            minV = _mm_min_ps(minV, v);
+            maxV = _mm_max_ps(maxV, v);
+            int mask = _mm_movemask_ps(_mm_cmpge_ps(v, passV));
+            passed += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+            __m128i ids = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(v, scale), _mm_setzero_ps()), lastBucket));
+            for (int b = 0; b < ScoreSummary::BUCKETS; ++b) {
+                bucketCounts[b] = _mm_sub_epi32(bucketCounts[b], _mm_cmpeq_epi32(ids, _mm_set1_epi32(b)));
             }
         }
-        cout << "Event not found!\n";
+        uint32_t laneCounts[4];
+        for (int b = 0; b < ScoreSummary::BUCKETS; ++b) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(laneCounts), bucketCounts[b]);
+            summary.buckets[b] += laneCounts[0] + laneCounts[1] + laneCounts[2] + laneCounts[3];
+        }
+        double lanes[2];
+        float floatLanes[4];
+        _mm_storeu_pd(lanes, _mm_add_pd(sumLo, sumHi));
+        sum = lanes[0] + lanes[1];
+        _mm_storeu_pd(lanes, _mm_add_pd(sqLo, sqHi));
+        sumSquares = lanes[0] + lanes[1];
+        _mm_storeu_ps(floatLanes, minV);
+        low = *min_element(floatLanes, floatLanes + 4);
+        _mm_storeu_ps(floatLanes, maxV);
+        high = *max_element(floatLanes, floatLanes + 4);
+#endif
+        for (; i < n; ++i) {
+            float v = scores[i];
+            sum += v;
+            sumSquares += double(v) * v;
+            low = min(low, v);
+            high = max(high, v);
+            passed += v >= passMark;
+            ++summary.buckets[bucketOf(v)];
+        }
+        summary.mean = sum / n;
+        summary.stddev = sqrt(max(0.0, sumSquares / n - summary.mean * summary.mean));
+        summary.min = low;
+        summary.max = high;
+        summary.passRate = double(passed) / n;
+        return summary;
     }
 
-    void viewEvents() const {
-        if (events.empty()) {
-            cout << "No events available.\n";
-            return;
-        }
-        cout << "Events:\n";
-        for (const auto& event : events) {
-            event.displayEvent();
-            cout << "-------------------------\n";
+    static void display(const ScoreSummary& summary, OutputSink& out) {
+        out << "  Count: " << summary.count << " | Mean: " << summary.mean << " | Std Dev: " << summary.stddev
+            << " | Min: " << summary.min << " | Max: " << summary.max
+            << " | Pass Rate: " << summary.passRate * 100 << "%\n";
+        out << "  Distribution:";
+        for (int b = 0; b < ScoreSummary::BUCKETS; ++b) {
+            out << " [" << b * 10;
+            if (b == ScoreSummary::BUCKETS - 1) {
+                out << "+";
+            } else {
+                out << "-" << b * 10 + 9;
+            }
+            out << "]: " << summary.buckets[b];
         }
+        out << "\n";
     }
 };
 
-class StudentInformationSystem {
+class Gradebook {
 private:
-    vector<User*> users;
-    vector<Course> courses;
-    NoticeBoard noticeBoard;
-    Library library;
-    Hostel hostel;
+    // Student and course each keep their full 32 bits, so no interned id can alias another row.
+    struct RowKey {
+        uint64_t studentCourse;
+        uint32_t exam;
+
+        bool operator==(const RowKey& other) const { return studentCourse == other.studentCourse && exam == other.exam; }
+    };
+
+    struct RowKeyHash {
+        size_t operator()(const RowKey& key) const {
+            return hash<uint64_t>()(key.studentCourse ^ (uint64_t(key.exam) * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    template <typename V>
+    struct Columns {
+        vector<int> studentIds;
+        vector<int> courses;
+        vector<int> exams;
+        vector<V> values;
+        unordered_map<RowKey, size_t, RowKeyHash> rows;
+        unordered_map<int, vector<size_t>> byStudent;
+        vector<vector<size_t>> byCourse;
+
+        static RowKey key(int studentId, int course, int exam) {
+            return {(uint64_t(uint32_t(studentId)) << 32) | uint32_t(course), uint32_t(exam)};
+        }
+
+        bool contains(int studentId, int course, int exam) const {
+            return rows.count(key(studentId, course, exam)) > 0;
+        }
+
+        void set(int studentId, int course, int exam, V value) {
+            auto it = rows.find(key(studentId, course, exam));
+            if (it != rows.end()) {
+                values[it->second] = value;
+                return;
+            }
+            size_t row = values.size();
+            rows.emplace(key(studentId, course, exam), row);
+            byStudent[studentId].push_back(row);
+            if (size_t(course) >= byCourse.size()) {
+                byCourse.resize(course + 1);
+            }
+            byCourse[course].push_back(row);
+            studentIds.push_back(studentId);
+            courses.push_back(course);
+            exams.push_back(exam);
+            values.push_back(value);
+        }
+
+        size_t size() const { return values.size(); }
+
+        size_t heapBytes() const {
+            size_t bytes = studentIds.capacity() * sizeof(int) + courses.capacity() * sizeof(int)
+                         + exams.capacity() * sizeof(int) + values.capacity() * sizeof(V);
+            bytes += rows.size() * (sizeof(pair<const RowKey, size_t>) + sizeof(void*)) + rows.bucket_count() * sizeof(void*);
+            bytes += 2 * values.size() * sizeof(size_t);
+            bytes += byStudent.size() * (sizeof(pair<const int, vector<size_t>>) + 2 * sizeof(void*));
+            bytes += byCourse.capacity() * sizeof(vector<size_t>);
+            return bytes;
+        }
+    };
+
+    static const int LOW_ATTENDANCE = 75;
+
+    // Running counters per (student, course); a hand-entered percentage only shows until sessions are held.
+    struct AttendanceTally {
+        uint32_t attended;
+        uint32_t held;
+        int recorded;
+        bool entered;
+
+        int percent() const {
+            return held ? int((uint64_t(attended) * 100 + held / 2) / held) : recorded;
+        }
+
+        bool low() const { return (held > 0 || entered) && percent() < LOW_ATTENDANCE; }
+    };
+
+    struct RunningMean {
+        double sum;
+        size_t count;
+    };
+
+    // One class meeting: a presence bit per seat, seats numbered in the order students joined the course.
+    struct ClassSession {
+        string date;
+        uint32_t seats;
+        vector<uint64_t> present;
+    };
+
+    // Tallies sit beside their seats so a session walks memory in order; byId is rebuilt lazily for lookups.
+    struct ClassRegister {
+        vector<int> students;
+        vector<AttendanceTally> tallies;
+        vector<ClassSession> sessions;
+        vector<pair<int, uint32_t>> byId;
+    };
+
+    CourseRegistry& catalog;
+    vector<string> examTypes;
+    unordered_map<string, int> examIndex;
+    Columns<float> scores;
+    Columns<uint32_t> attendance;
+    vector<ClassRegister> classes;
+    Columns<float> finalGrades;
+    vector<RunningMean> gradeTotals;
+    vector<vector<RunningMean>> examTotals;
+    unordered_map<int, uint32_t> lowCourses;
+    size_t sessionTotal;
+    WriteAheadLog* journal;
+    // Faculty writes run concurrently under per-user stripes, so the book guards its own tables.
+    mutable shared_timed_mutex bookLock;
+
+public:
+    struct GradeAverage {
+        string courseCode;
+        float mean;
+        size_t count;
+    };
+
+    struct FinalGradeRow {
+        int studentId;
+        string courseCode;
+        float grade;
+    };
+
+    // Indexed by CourseId; rows carry their own code so a pinned view never touches the live catalog.
+    typedef vector<vector<FinalGradeRow>> FinalGradeView;
+
+private:
+    mutable PublishedView<FinalGradeView> publishedGrades;
+
+    static int intern(vector<string>& names, unordered_map<string, int>& index, const string& name) {
+        auto it = index.find(name);
+        if (it != index.end()) {
+            return it->second;
+        }
+        names.push_back(name);
+        index.emplace(name, int(names.size() - 1));
+        return int(names.size() - 1);
+    }
+
+    template <typename V>
+    void sortRows(const Columns<V>& columns, vector<size_t>& order) const {
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (columns.studentIds[a] != columns.studentIds[b]) {
+                return columns.studentIds[a] < columns.studentIds[b];
+            }
+            if (columns.courses[a] != columns.courses[b]) {
+                return catalog.code(columns.courses[a]) < catalog.code(columns.courses[b]);
+            }
+            return examTypes[columns.exams[a]] < examTypes[columns.exams[b]];
+        });
+    }
+
+    template <typename V>
+    vector<size_t> rowsOfStudent(const Columns<V>& columns, int studentId) const {
+        vector<size_t> order;
+        auto it = columns.byStudent.find(studentId);
+        if (it != columns.byStudent.end()) {
+            order = it->second;
+        }
+        sortRows(columns, order);
+        return order;
+    }
+
+    template <typename V>
+    vector<size_t> rowsInCourses(const Columns<V>& columns, const vector<CourseId>& courses) const {
+        vector<size_t> order;
+        for (CourseId course : courses) {
+            if (course < columns.byCourse.size()) {
+                order.insert(order.end(), columns.byCourse[course].begin(), columns.byCourse[course].end());
+            }
+        }
+        sortRows(columns, order);
+        order.erase(unique(order.begin(), order.end()), order.end());
+        return order;
+    }
+
+    template <typename F>
+    void visitScores(const vector<size_t>& order, F visit) const {
+        for (size_t row : order) {
+            visit(scores.studentIds[row], catalog.code(scores.courses[row]), examTypes[scores.exams[row]], scores.values[row]);
+        }
+    }
+
+    template <typename V, typename F>
+    void visitCourseValues(const Columns<V>& columns, const vector<size_t>& order, F visit) const {
+        for (size_t row : order) {
+            visit(columns.studentIds[row], catalog.code(columns.courses[row]), columns.values[row]);
+        }
+    }
+
+    template <typename F>
+    void visitAttendance(const vector<size_t>& order, F visit) const {
+        for (size_t row : order) {
+            CourseId course = CourseId(attendance.courses[row]);
+            visit(attendance.studentIds[row], catalog.code(course), classes[course].tallies[attendance.values[row]].percent());
+        }
+    }
+
+    AttendanceTally& seatTally(int studentId, CourseId course) {
+        if (course >= classes.size()) {
+            classes.resize(course + 1);
+        }
+        ClassRegister& roll = classes[course];
+        auto it = attendance.rows.find(Columns<uint32_t>::key(studentId, int(course), 0));
+        if (it != attendance.rows.end()) {
+            return roll.tallies[attendance.values[it->second]];
+        }
+        attendance.set(studentId, int(course), 0, uint32_t(roll.students.size()));
+        roll.students.push_back(studentId);
+        roll.tallies.push_back(AttendanceTally{0, 0, 0, false});
+        return roll.tallies.back();
+    }
+
+    // lowCourses counts, per student, the courses currently below LOW_ATTENDANCE.
+    void trackLow(int studentId, bool wasLow, bool isLow) {
+        if (wasLow == isLow) {
+            return;
+        }
+        if (isLow) {
+            ++lowCourses[studentId];
+            return;
+        }
+        auto it = lowCourses.find(studentId);
+        if (--it->second == 0) {
+            lowCourses.erase(it);
+        }
+    }
+
+    void applySession(CourseId course, const ClassSession& session) {
+        ClassRegister& roll = classes[course];
+        for (uint32_t seat = 0; seat < session.seats; ++seat) {
+            AttendanceTally& tally = roll.tallies[seat];
+            bool wasLow = tally.low();
+            ++tally.held;
+            tally.attended += (session.present[seat / 64] >> (seat % 64)) & 1;
+            trackLow(roll.students[seat], wasLow, tally.low());
+        }
+    }
+
+    static RunningMean& slot(vector<RunningMean>& totals, size_t index) {
+        if (index >= totals.size()) {
+            totals.resize(index + 1, RunningMean{0, 0});
+        }
+        return totals[index];
+    }
+
+    RunningMean& examTotal(CourseId course, int exam) {
+        if (course >= examTotals.size()) {
+            examTotals.resize(course + 1);
+        }
+        return slot(examTotals[course], exam);
+    }
+
+    // Sets a value and folds the change into its running total.
+    static void setCounted(Columns<float>& columns, RunningMean& total, int studentId, CourseId course, int exam, float value) {
+        auto it = columns.rows.find(Columns<float>::key(studentId, int(course), exam));
+        if (it != columns.rows.end()) {
+            total.sum += double(value) - columns.values[it->second];
+            columns.values[it->second] = value;
+            return;
+        }
+        total.sum += value;
+        ++total.count;
+        columns.set(studentId, int(course), exam, value);
+    }
+
+    bool averageOf(CourseId course, GradeAverage& average) const {
+        if (course >= gradeTotals.size() || gradeTotals[course].count == 0) {
+            return false;
+        }
+        average = {catalog.code(course), float(gradeTotals[course].sum / gradeTotals[course].count), gradeTotals[course].count};
+        return true;
+    }
+
+    static bool sameTotal(const vector<RunningMean>& totals, size_t index, const RunningMean& expected) {
+        RunningMean kept = index < totals.size() ? totals[index] : RunningMean{0, 0};
+        return kept.count == expected.count && fabs(kept.sum - expected.sum) <= 1e-6 * max(1.0, fabs(expected.sum));
+    }
+
+    static string encodePresence(const ClassSession& session) {
+        static const char digits[] = "0123456789abcdef";
+        string hex((session.seats + 3) / 4, '0');
+        for (size_t i = 0; i < hex.size(); ++i) {
+            hex[i] = digits[(session.present[i / 16] >> (i % 16 * 4)) & 0xf];
+        }
+        return hex;
+    }
+
+    static bool decodePresence(const string& hex, ClassSession& session) {
+        if (hex.size() != (session.seats + 3) / 4) {
+            return false;
+        }
+        session.present.assign((session.seats + 63) / 64, 0);
+        for (size_t i = 0; i < hex.size(); ++i) {
+            char c = hex[i];
+            uint64_t nibble = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : 16;
+            if (nibble == 16) {
+                return false;
+            }
+            session.present[i / 16] |= nibble << (i % 16 * 4);
+        }
+        return true;
+    }
+
+public:
+    struct ExamAverage {
+        string courseCode;
+        string examType;
+        float mean;
+        size_t count;
+    };
+
+    explicit Gradebook(CourseRegistry& courses) : catalog(courses), sessionTotal(0), journal(nullptr) {}
+
+    void setJournal(WriteAheadLog* log) { journal = log; }
+
+    void recordExamScore(int studentId, CourseId course, const string& examType, float score) {
+        unique_lock<shared_timed_mutex> guard(bookLock);
+        int exam = intern(examTypes, examIndex, examType);
+        setCounted(scores, examTotal(course, exam), studentId, course, exam, score);
+        if (journal) {
+            journal->append({"score", to_string(studentId), catalog.code(course), examType, to_string(score)});
+        }
+    }
+
+    void recordExamScore(int studentId, const string& courseCode, const string& examType, float score) {
+        recordExamScore(studentId, catalog.intern(courseCode), examType, score);
+    }
+
+    void recordAttendance(int studentId, CourseId course, int value) {
+        unique_lock<shared_timed_mutex> guard(bookLock);
+        AttendanceTally& tally = seatTally(studentId, course);
+        bool wasLow = tally.low();
+        tally.recorded = value;
+        tally.entered = true;
+        trackLow(studentId, wasLow, tally.low());
+        if (journal) {
+            journal->append({"attendance", to_string(studentId), catalog.code(course), to_string(value)});
+        }
+    }
+
+    void recordAttendance(int studentId, const string& courseCode, int value) {
+        recordAttendance(studentId, catalog.intern(courseCode), value);
+    }
+
+    void initAttendance(int studentId, CourseId course) {
+        unique_lock<shared_timed_mutex> guard(bookLock);
+        seatTally(studentId, course);
+    }
+
+    // Marks one class meeting over every seat in the course; ids without a seat are returned in rejected.
+    size_t recordSession(CourseId course, const string& date, const vector<int>& present, vector<int>& rejected) {
+        unique_lock<shared_timed_mutex> guard(bookLock);
+        if (course >= classes.size()) {
+            classes.resize(course + 1);
+        }
+        ClassRegister& roll = classes[course];
+        if (roll.byId.size() != roll.students.size()) {
+            roll.byId.clear();
+            for (uint32_t seat = 0; seat < roll.students.size(); ++seat) {
+                roll.byId.emplace_back(roll.students[seat], seat);
+            }
+            sort(roll.byId.begin(), roll.byId.end());
+        }
+        vector<int> sorted;
+        const vector<int>* ids = &present;
+        if (!is_sorted(present.begin(), present.end())) {
+            sorted = present;
+            sort(sorted.begin(), sorted.end());
+            ids = &sorted;
+        }
+        ClassSession session{date, uint32_t(roll.students.size()), vector<uint64_t>((roll.students.size() + 63) / 64, 0)};
+        size_t marked = 0;
+        auto seat = roll.byId.begin();
+        for (int studentId : *ids) {
+            while (seat != roll.byId.end() && seat->first < studentId) {
+                ++seat;
+            }
+            if (seat == roll.byId.end() || seat->first != studentId) {
+                rejected.push_back(studentId);
+                continue;
+            }
+            uint64_t bit = uint64_t(1) << (seat->second % 64);
+            if (!(session.present[seat->second / 64] & bit)) {
+                session.present[seat->second / 64] |= bit;
+                ++marked;
+            }
+        }
+        applySession(course, session);
+        if (journal) {
+            journal->append({"session", catalog.code(course), date, to_string(session.seats), encodePresence(session)});
+        }
+        roll.sessions.push_back(move(session));
+        ++sessionTotal;
+        return marked;
+    }
+
+    bool restoreSession(const string& courseCode, const string& date, uint32_t seats, const string& presence) {
+        unique_lock<shared_timed_mutex> guard(bookLock);
+        CourseId course = catalog.intern(courseCode);
+        if (course >= classes.size()) {
+            classes.resize(course + 1);
+        }
+        ClassSession session{date, seats, {}};
+        if (seats > classes[course].students.size() || !decodePresence(presence, session)) {
+            return false;
+        }
+        applySession(course, session);
+        classes[course].sessions.push_back(move(session));
+        ++sessionTotal;
+        return true;
+    }
+
+    // Puts a course's seats back in their recorded order before its sessions are replayed.
+    void restoreSeats(const string& courseCode, const vector<int>& studentIds) {
+        unique_lock<shared_timed_mutex> guard(bookLock);
+        CourseId course = catalog.intern(courseCode);
+        for (int studentId : studentIds) {
+            seatTally(studentId, course);
+        }
+        ClassRegister& roll = classes[course];
+        vector<uint32_t> order;
+        vector<char> placed(roll.students.size(), 0);
+        auto place = [&](uint32_t seat) {
+            if (!placed[seat]) {
+                placed[seat] = 1;
+                order.push_back(seat);
+            }
+        };
+        for (int studentId : studentIds) {
+            place(attendance.values[attendance.rows.at(Columns<uint32_t>::key(studentId, int(course), 0))]);
+        }
+        for (uint32_t seat = 0; seat < roll.students.size(); ++seat) {
+            place(seat);
+        }
+        ClassRegister reordered;
+        for (uint32_t seat : order) {
+            int studentId = roll.students[seat];
+            attendance.values[attendance.rows.at(Columns<uint32_t>::key(studentId, int(course), 0))] = uint32_t(reordered.students.size());
+            reordered.students.push_back(studentId);
+            reordered.tallies.push_back(roll.tallies[seat]);
+        }
+        reordered.sessions = move(roll.sessions);
+        roll = move(reordered);
+    }
+
+    size_t sessionsHeld(CourseId course) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        return course < classes.size() ? classes[course].sessions.size() : 0;
+    }
+
+    void assignFinalGrade(int studentId, CourseId course, float grade) {
+        unique_lock<shared_timed_mutex> guard(bookLock);
+        setCounted(finalGrades, slot(gradeTotals, course), studentId, course, 0, grade);
+        publishedGrades.invalidate();
+        if (journal) {
+            journal->append({"grade", to_string(studentId), catalog.code(course), to_string(grade)});
+        }
+    }
+
+    void assignFinalGrade(int studentId, const string& courseCode, float grade) {
+        assignFinalGrade(studentId, catalog.intern(courseCode), grade);
+    }
+
+    shared_ptr<const FinalGradeView> finalGradeSnapshot() const {
+        return publishedGrades.get([this](FinalGradeView& view) {
+            shared_lock<shared_timed_mutex> guard(bookLock);
+            view.resize(catalog.size());
+            for (size_t row = 0; row < finalGrades.size(); ++row) {
+                CourseId course = CourseId(finalGrades.courses[row]);
+                view[course].push_back({finalGrades.studentIds[row], catalog.code(course), finalGrades.values[row]});
+            }
+        });
+    }
+
+    static vector<FinalGradeRow> selectFinalGrades(const FinalGradeView& view, const vector<CourseId>& courses) {
+        vector<FinalGradeRow> rows;
+        for (CourseId course : courses) {
+            if (course < view.size()) {
+                rows.insert(rows.end(), view[course].begin(), view[course].end());
+            }
+        }
+        sort(rows.begin(), rows.end(), [](const FinalGradeRow& a, const FinalGradeRow& b) {
+            return a.studentId != b.studentId ? a.studentId < b.studentId : a.courseCode < b.courseCode;
+        });
+        return rows;
+    }
+
+    template <typename F>
+    void forEachScoreOfStudent(int studentId, F visit) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        visitScores(rowsOfStudent(scores, studentId), visit);
+    }
+
+    template <typename F>
+    void forEachAttendanceOfStudent(int studentId, F visit) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        visitAttendance(rowsOfStudent(attendance, studentId), visit);
+    }
+
+    template <typename F>
+    void forEachFinalGradeOfStudent(int studentId, F visit) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        visitCourseValues(finalGrades, rowsOfStudent(finalGrades, studentId), visit);
+    }
+
+    template <typename F>
+    void forEachScoreInCourses(const vector<CourseId>& courses, F visit) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        visitScores(rowsInCourses(scores, courses), visit);
+    }
+
+    template <typename F>
+    void forEachAttendanceInCourses(const vector<CourseId>& courses, F visit) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        visitAttendance(rowsInCourses(attendance, courses), visit);
+    }
+
+    template <typename F>
+    void forEachFinalGradeInCourses(const vector<CourseId>& courses, F visit) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        visitCourseValues(finalGrades, rowsInCourses(finalGrades, courses), visit);
+    }
+
+    void collectScores(map<pair<string, string>, vector<float>>& groups) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        for (size_t i = 0; i < scores.size(); ++i) {
+            groups[make_pair(catalog.code(scores.courses[i]), examTypes[scores.exams[i]])].push_back(scores.values[i]);
+        }
+    }
+
+    vector<ExamAverage> examAverages(vector<CourseId> courses) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        sort(courses.begin(), courses.end());
+        courses.erase(unique(courses.begin(), courses.end()), courses.end());
+        vector<ExamAverage> averages;
+        for (CourseId course : courses) {
+            if (course >= examTotals.size()) {
+                continue;
+            }
+            for (size_t exam = 0; exam < examTotals[course].size(); ++exam) {
+                const RunningMean& total = examTotals[course][exam];
+                if (total.count > 0) {
+                    averages.push_back({catalog.code(course), examTypes[exam], float(total.sum / total.count), total.count});
+                }
+            }
+        }
+        sort(averages.begin(), averages.end(), [](const ExamAverage& a, const ExamAverage& b) {
+            return a.courseCode != b.courseCode ? a.courseCode < b.courseCode : a.examType < b.examType;
+        });
+        return averages;
+    }
+
+    bool finalGradeAverage(CourseId course, GradeAverage& average) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        return averageOf(course, average);
+    }
+
+    vector<GradeAverage> finalGradeAverages() const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        vector<GradeAverage> averages;
+        GradeAverage average;
+        for (CourseId course = 0; course < gradeTotals.size(); ++course) {
+            if (averageOf(course, average)) {
+                averages.push_back(average);
+            }
+        }
+        sort(averages.begin(), averages.end(), [](const GradeAverage& a, const GradeAverage& b) { return a.courseCode < b.courseCode; });
+        return averages;
+    }
+
+    static int lowAttendanceMark() { return LOW_ATTENDANCE; }
+
+    size_t lowAttendanceCount() const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        return lowCourses.size();
+    }
+
+    vector<int> lowAttendanceStudents() const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        vector<int> students;
+        students.reserve(lowCourses.size());
+        for (const auto& entry : lowCourses) {
+            students.push_back(entry.first);
+        }
+        sort(students.begin(), students.end());
+        return students;
+    }
+
+    // Recounts every aggregate from the raw rows and session bitsets; mismatches are appended to problems.
+    bool verifyAggregates(vector<string>& problems) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        size_t before = problems.size();
+        vector<RunningMean> grades;
+        for (size_t row = 0; row < finalGrades.size(); ++row) {
+            RunningMean& total = slot(grades, finalGrades.courses[row]);
+            total.sum += finalGrades.values[row];
+            ++total.count;
+        }
+        for (size_t course = 0; course < max(grades.size(), gradeTotals.size()); ++course) {
+            if (!sameTotal(gradeTotals, course, course < grades.size() ? grades[course] : RunningMean{0, 0})) {
+                problems.push_back("final grade total for " + catalog.code(CourseId(course)) + " differs from a recount");
+            }
+        }
+        vector<vector<RunningMean>> exams(max(examTotals.size(), size_t(catalog.size())));
+        for (size_t row = 0; row < scores.size(); ++row) {
+            RunningMean& total = slot(exams[scores.courses[row]], scores.exams[row]);
+            total.sum += scores.values[row];
+            ++total.count;
+        }
+        for (size_t course = 0; course < exams.size(); ++course) {
+            static const vector<RunningMean> none;
+            const vector<RunningMean>& kept = course < examTotals.size() ? examTotals[course] : none;
+            for (size_t exam = 0; exam < max(kept.size(), exams[course].size()); ++exam) {
+                if (!sameTotal(kept, exam, exam < exams[course].size() ? exams[course][exam] : RunningMean{0, 0})) {
+                    problems.push_back("exam total for " + catalog.code(CourseId(course)) + " " + examTypes[exam] + " differs from a recount");
+                }
+            }
+        }
+        unordered_map<int, uint32_t> low;
+        for (size_t course = 0; course < classes.size(); ++course) {
+            const ClassRegister& roll = classes[course];
+            vector<uint32_t> held(roll.tallies.size(), 0), attended(roll.tallies.size(), 0);
+            for (const auto& session : roll.sessions) {
+                for (uint32_t seat = 0; seat < session.seats; ++seat) {
+                    ++held[seat];
+                    attended[seat] += (session.present[seat / 64] >> (seat % 64)) & 1;
+                }
+            }
+            for (size_t seat = 0; seat < roll.tallies.size(); ++seat) {
+                if (roll.tallies[seat].held != held[seat] || roll.tallies[seat].attended != attended[seat]) {
+                    problems.push_back("attendance counters for student " + to_string(roll.students[seat]) + " in "
+                                       + catalog.code(CourseId(course)) + " differ from its sessions");
+                }
+                if (roll.tallies[seat].low()) {
+                    ++low[roll.students[seat]];
+                }
+            }
+        }
+        if (low != lowCourses) {
+            problems.push_back("low attendance set holds " + to_string(lowCourses.size()) + " students, a recount finds " + to_string(low.size()));
+        }
+        return problems.size() == before;
+    }
+
+    size_t size() const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        return scores.size() + attendance.size() + finalGrades.size();
+    }
+
+    // Rows plus class sessions; the per-course seat records are bounded by the sessions.
+    size_t recordCount() const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        return scores.size() + attendance.size() + finalGrades.size() + sessionTotal;
+    }
+
+    size_t heapBytes() const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        size_t bytes = scores.heapBytes() + attendance.heapBytes() + finalGrades.heapBytes();
+        bytes += classes.capacity() * sizeof(ClassRegister) + gradeTotals.capacity() * sizeof(RunningMean)
+               + examTotals.capacity() * sizeof(vector<RunningMean>);
+        for (const auto& totals : examTotals) {
+            bytes += totals.capacity() * sizeof(RunningMean);
+        }
+        bytes += lowCourses.size() * (sizeof(pair<const int, uint32_t>) + sizeof(void*)) + lowCourses.bucket_count() * sizeof(void*);
+        for (const auto& roll : classes) {
+            bytes += roll.students.capacity() * sizeof(int) + roll.tallies.capacity() * sizeof(AttendanceTally)
+                   + roll.byId.capacity() * sizeof(pair<int, uint32_t>) + roll.sessions.capacity() * sizeof(ClassSession);
+            for (const auto& session : roll.sessions) {
+                bytes += session.present.capacity() * sizeof(uint64_t) + stringHeapBytes(session.date);
+            }
+        }
+        for (const auto& exam : examTypes) {
+            bytes += sizeof(string) + stringHeapBytes(exam);
+        }
+        return bytes;
+    }
+
+    void writeState(ostream& out) const {
+        shared_lock<shared_timed_mutex> guard(bookLock);
+        for (size_t i = 0; i < attendance.size(); ++i) {
+            const AttendanceTally& tally = classes[attendance.courses[i]].tallies[attendance.values[i]];
+            if (tally.entered) {
+                WriteAheadLog::writeRecord(out, {"attendance", to_string(attendance.studentIds[i]), catalog.code(attendance.courses[i]), to_string(tally.recorded)});
+            }
+        }
+        for (CourseId course = 0; course < classes.size(); ++course) {
+            if (classes[course].sessions.empty()) {
+                continue;
+            }
+            vector<string> seats = {"class-seats", catalog.code(course)};
+            for (int studentId : classes[course].students) {
+                seats.push_back(to_string(studentId));
+            }
+            WriteAheadLog::writeRecord(out, seats);
+            for (const auto& session : classes[course].sessions) {
+                WriteAheadLog::writeRecord(out, {"session", catalog.code(course), session.date, to_string(session.seats), encodePresence(session)});
+            }
+        }
+        for (size_t i = 0; i < scores.size(); ++i) {
+            WriteAheadLog::writeRecord(out, {"score", to_string(scores.studentIds[i]), catalog.code(scores.courses[i]), examTypes[scores.exams[i]], to_string(scores.values[i])});
+        }
+        for (size_t i = 0; i < finalGrades.size(); ++i) {
+            WriteAheadLog::writeRecord(out, {"grade", to_string(finalGrades.studentIds[i]), catalog.code(finalGrades.courses[i]), to_string(finalGrades.values[i])});
+        }
+    }
+};
+
+class Student : public User {
+private:
+    int id;
+    int age;
+    string course;
+    vector<CourseId> enrolledCourses;
+    CourseRegistry* catalog;
+    EnrollmentIndex* enrollments;
+    Gradebook* records;
+    FeeLedger* ledger;
+
+public:
+    Student(string u, string p, int id, int age, string course, CourseRegistry* catalog, EnrollmentIndex* enrollments, Gradebook* records, FeeLedger* ledger)
+        : User(u, p, "student"), id(id), age(age), course(course), catalog(catalog), enrollments(enrollments), records(records), ledger(ledger) {}
+
+    Student* asStudent() override { return this; }
+
+    size_t heapBytes() const {
+        size_t bytes = stringHeapBytes(username) + stringHeapBytes(password) + stringHeapBytes(role) + stringHeapBytes(course);
+        bytes += enrolledCourses.capacity() * sizeof(CourseId);
+        return bytes;
+    }
+
+    int getId() const { return id; }
+    int getAge() const { return age; } 
+    const string& getCourse() const { return course; }
+
+    Cents getFeeAmount() const {
+        Cents charged = 0, paid = 0;
+        ledger->balance(id, charged, paid);
+        return charged;
+    }
+
+    Cents getPaidAmount() const {
+        Cents charged = 0, paid = 0;
+        ledger->balance(id, charged, paid);
+        return paid;
+    }
+    
+    void setFinalGrade(const string& courseCode, float grade) {
+        records->assignFinalGrade(id, courseCode, grade);
+    }
+
+    bool addCourse(const string& courseCode, const string& courseName) {
+        CourseId course = catalog->intern(courseCode, courseName);
+        if (!enrollments->enroll(id, course)) {
+            return false;
+        }
+        enrolledCourses.push_back(course);
+        records->initAttendance(id, course);
+        if (journal) {
+            journal->append({"enroll", username, courseCode, courseName});
+        }
+        return true;
+    }
+
+    void recordExamScore(const string& courseCode, const string& examType, float score) {
+        records->recordExamScore(id, courseCode, examType, score);
+    }
+
+    void viewExamScores() const {
+        StreamSink out(cout);
+        viewExamScores(out);
+    }
+
+    void viewExamScores(OutputSink& out) const {
+        bool any = false;
+        string currentCourse;
+        records->forEachScoreOfStudent(id, [&](int, const string& courseCode, const string& examType, float score) {
+            if (!any) {
+                out << "Exam Scores:\n";
+                any = true;
+            }
+            if (courseCode != currentCourse) {
+                out << "Course: " << courseCode << "\n ";
+                currentCourse = courseCode;
+            }
+            out << "  Exam: " << examType << " | Score: " << score << "\n";
+        });
+        if (!any) {
+            out << "No exam scores recorded.\n";
+        }
+    }
+
+    void viewAttendance() const {
+        StreamSink out(cout);
+        viewAttendance(out);
+    }
+
+    void viewAttendance(OutputSink& out) const {
+        bool any = false;
+        records->forEachAttendanceOfStudent(id, [&](int, const string& courseCode, int value) {
+            if (!any) {
+                out << "Attendance Report:\n";
+                any = true;
+            }
+            out << "Course: " << courseCode << " | Attendance: " << value << "%\n";
+        });
+        if (!any) {
+            out << "No attendance recorded.\n";
+        }
+    }
+
+    void viewGrades() const {
+        StreamSink out(cout);
+        viewGrades(out);
+    }
+
+    void viewGrades(OutputSink& out) const {
+        bool any = false;
+        records->forEachFinalGradeOfStudent(id, [&](int, const string& courseCode, float grade) {
+            any = true;
+            out << "Course: " << courseCode << " | Final Grade: " << grade << "\n";
+        });
+        if (!any) {
+            out << "No final grades assigned.\n";
+        }
+    }
+
+    void displayEnrolledCourses() const {
+        StreamSink out(cout);
+        displayEnrolledCourses(out);
+    }
+
+    void displayEnrolledCourses(OutputSink& out) const {
+        if (enrolledCourses.empty()) {
+            out << "No courses enrolled.\n";
+            return;
+        }
+        out << "Enrolled Courses:\n";
+        for (CourseId course : enrolledCourses) {
+            catalog->course(course).displayCourse(out);
+        }
+    }
+
+    void viewFees() const {
+        StreamSink out(cout);
+        viewFees(out);
+    }
+
+    void viewFees(OutputSink& out) const {
+        Cents charged = 0, paid = 0;
+        ledger->balance(id, charged, paid);
+        out << "Total Amount: $" << formatMoney(charged) << ", Amount Paid: $" << formatMoney(paid) << "\n";
+        out << "Amount Due: $" << formatMoney(charged - paid) << "\n";
+    }
+
+    void viewPaymentHistory() const {
+        StreamSink out(cout);
+        viewPaymentHistory(out);
+    }
+
+    void viewInstructors() const {
+        StreamSink out(cout);
+        viewInstructors(out);
+    }
+
+    void viewInstructors(OutputSink& out) const {
+        vector<string> names = enrollments->facultyOf(id);
+        if (names.empty()) {
+            out << "No instructors assigned to your courses.\n";
+            return;
+        }
+        out << "Instructors:\n";
+        for (const auto& name : names) {
+            out << name << "\n";
+        }
+    }
+
+    void viewPaymentHistory(OutputSink& out) const {
+        vector<FeeLedger::Entry> entries = ledger->history(id);
+        if (entries.empty()) {
+            out << "No fee transactions recorded.\n";
+            return;
+        }
+        out << "Fee Transactions:\n";
+        Cents due = 0;
+        for (const auto& entry : entries) {
+            if (entry.kind == FeeLedger::EntryKind::Charge) {
+                due += entry.amount;
+                out << "Charge: $" << formatMoney(entry.amount);
+            } else {
+                due -= entry.amount;
+                out << "Payment: $" << formatMoney(entry.amount) << " on " << TimestampFormatter::format(time_t(entry.posted));
+                if (entry.batch != 0) {
+                    out << " (batch " << entry.batch << ")";
+                }
+            }
+            out << " | Due: $" << formatMoney(due) << "\n";
+        }
+    }
+
+    void writeTranscript(OutputSink& out) const {
+        out << "Transcript for " << username << " (Student ID: " << id << ")\n";
+        out << "Age: " << age << " | Program: " << course << "\n";
+        displayEnrolledCourses(out);
+        viewAttendance(out);
+        viewExamScores(out);
+        viewGrades(out);
+        viewFees(out);
+        out << "=========================\n";
+    }
+
+    bool makePayment(Cents amount) {
+        FeeLedger::PostStatus status = ledger->post(id, amount);
+        if (status == FeeLedger::PostStatus::InvalidAmount) {
+            cout << "Invalid payment amount!\n";
+            return false;
+        }
+        if (status != FeeLedger::PostStatus::Posted) {
+            cout << "Payment exceeds total amount due!\n";
+            return false;
+        }
+        Cents charged = 0, paid = 0;
+        ledger->balance(id, charged, paid);
+        StreamSink out(cout);
+        out << "Payment of $" << formatMoney(amount) << " successful. Total Paid: $" << formatMoney(paid) << "\n";
+        out << "Amount Due: $" << formatMoney(charged - paid) << "\n";
+        return true;
+    }
+
+    void writeState(ostream& out) const override {
+        for (CourseId id : enrolledCourses) {
+            const Course& course = catalog->course(id);
+            WriteAheadLog::writeRecord(out, {"enroll", username, course.getCourseCode(), course.getCourseName()});
+        }
+    }
+
+    void menu() override {
+        int choice;
+        do {
+            cout << "\nStudent Menu\n";
+            cout << "1. Add Course\n";
+            cout << "2. View Enrolled Courses\n";
+            cout << "3. View Grades\n";
+            cout << "4. View Attendance\n";
+            cout << "5. View Exam Scores\n";
+            cout << "6. View Fees\n";
+            cout << "7. Make Payment\n";
+            cout << "8. View Payment History\n";
+            cout << "9. View Instructors\n";
+            cout << "10. Logout\n";
+            cout << "Enter your choice: ";
+            cin >> choice;
+
+            switch (choice) {
+                case 1: {
+                    string courseCode, courseName;
+                    cout << "Enter Course Code: ";
+                    cin >> courseCode;
+                    cin.ignore();
+                    cout << "Enter Course Name: ";
+                    getline(cin, courseName);
+                    if (addCourse(courseCode, courseName)) {
+                        cout << "Course added successfully!\n";
+                    } else {
+                        cout << "You are already enrolled in " << courseCode << "!\n";
+                    }
+                    break;
+                }
+                case 2:
+                    displayEnrolledCourses();
+                    break;
+                case 3:
+                    viewGrades();
+                    break;
+                case 4:
+                    viewAttendance();
+                    break;
+                case 5:
+                    viewExamScores();
+                    break;
+                case 6:
+                    viewFees();
+                    break;
+                case 7: {
+                    string paymentAmount;
+                    Cents amount;
+                    cout << "Enter payment amount: ";
+                    cin >> paymentAmount;
+                    if (!parseMoney(paymentAmount, amount)) {
+                        cout << "Invalid payment amount!\n";
+                    } else {
+                        makePayment(amount);
+                    }
+                    break;
+                }
+                case 8:
+                    viewPaymentHistory();
+                    break;
+                case 9:
+                    viewInstructors();
+                    break;
+                case 10:
+                    cout << "Logging out...\n";
+                    break;
+                default:
+                    cout << "Invalid choice! Please try again.\n";
+            }
+        } while (choice != 10);
+    }
+};
+
+class Faculty : public User {
+private:
+    vector<CourseId> assignedCourses;
+    CourseRegistry* catalog;
+    EnrollmentIndex* enrollments;
+    Gradebook* records;
+
+    bool teaches(const string& courseCode, CourseId& course) const {
+        if (catalog->find(courseCode, course) && find(assignedCourses.begin(), assignedCourses.end(), course) != assignedCourses.end()) {
+            return true;
+        }
+        cout << "Course " << courseCode << " is not assigned to you!\n";
+        return false;
+    }
+
+public:
+    Faculty(string u, string p, CourseRegistry* catalog, EnrollmentIndex* enrollments, Gradebook* records)
+        : User(u, p, "faculty"), catalog(catalog), enrollments(enrollments), records(records) {}
+
+    const vector<CourseId>& assignedCourseIds() const { return assignedCourses; }
+
+    Faculty* asFaculty() override { return this; }
+
+    void assignCourse(const string& courseCode, const string& courseName) {
+        CourseId course = catalog->intern(courseCode, courseName);
+        assignedCourses.push_back(course);
+        enrollments->teach(username, course);
+        if (journal) {
+            journal->append({"teach", username, courseCode, courseName});
+        }
+    }
+
+    bool recordAttendance(int studentId, string courseCode, int attendance) {
+        CourseId course;
+        if (!teaches(courseCode, course)) {
+            return false;
+        }
+        if (!enrollments->contains(studentId, course)) {
+            cout << "Student ID " << studentId << " is not enrolled in " << courseCode << "!\n";
+            return false;
+        }
+        records->recordAttendance(studentId, course, attendance);
+        cout << "Attendance recorded for Student ID: " << studentId << " in Course: " << courseCode << ".\n";
+        return true;
+    }
+
+    bool recordSession(const string& courseCode, const string& date, const vector<int>& present) {
+        CourseId course;
+        if (!teaches(courseCode, course)) {
+            return false;
+        }
+        vector<int> enrolled, rejected;
+        enrollments->splitEnrolled(course, present, enrolled, rejected);
+        size_t marked = records->recordSession(course, date, enrolled, rejected);
+        cout << "Session on " << date << " recorded for " << courseCode << ": " << marked << " present, "
+             << enrollments->headcount(course) - marked << " absent.\n";
+        if (!rejected.empty()) {
+            cout << rejected.size() << " student ID(s) not enrolled in " << courseCode << " were skipped.\n";
+        }
+        return true;
+    }
+
+    bool recordExamScore(int studentId, string courseCode, string examType, float score) {
+        CourseId course;
+        if (!teaches(courseCode, course)) {
+            return false;
+        }
+        records->recordExamScore(studentId, course, examType, score);
+        cout << "Exam score recorded for Student ID: " << studentId << " in Course: " << courseCode << " for " << examType << " exam.\n";
+        return true;
+    }
+
+    bool assignFinalGrade(int studentId, string courseCode, float grade) {
+        CourseId course;
+        if (!teaches(courseCode, course)) {
+            return false;
+        }
+        records->assignFinalGrade(studentId, course, grade);
+        cout << "Final grade assigned for Student ID: " << studentId << " in Course: " << courseCode << ".\n";
+        return true;
+    }
+
+    void writeState(ostream& out) const override {
+        for (CourseId id : assignedCourses) {
+            const Course& course = catalog->course(id);
+            WriteAheadLog::writeRecord(out, {"teach", username, course.getCourseCode(), course.getCourseName()});
+        }
+    }
+
+    void viewStudentAttendance() const {
+        StreamSink out(cout);
+        viewStudentAttendance(out);
+    }
+
+    void viewStudentAttendance(OutputSink& out) const {
+        int currentStudent = 0;
+        bool first = true;
+        records->forEachAttendanceInCourses(assignedCourses, [&](int studentId, const string& courseCode, int value) {
+            if (first) {
+                out << "Attendance Records for Assigned Courses:\n";
+            }
+            if (first || studentId != currentStudent) {
+                out << "Student ID: " << studentId << "\n";
+                currentStudent = studentId;
+                first = false;
+            }
+            out << "  Course: " << courseCode << " | Attendance: " << value << "%\n";
+        });
+        if (first) {
+            out << "No attendance records available.\n";
+        }
+    }
+
+    void viewStudentExamScores() const {
+        StreamSink out(cout);
+        viewStudentExamScores(out);
+    }
+
+    void viewStudentExamScores(OutputSink& out) const {
+        int currentStudent = 0;
+        string currentCourse;
+        bool first = true;
+        records->forEachScoreInCourses(assignedCourses, [&](int studentId, const string& courseCode, const string& examType, float score) {
+            if (first) {
+                out << "Exam Scores for Assigned Courses:\n";
+            }
+            if (first || studentId != currentStudent) {
+                out << "Student ID: " << studentId << "\n";
+                currentStudent = studentId;
+                currentCourse.clear();
+                first = false;
+            }
+            if (courseCode != currentCourse) {
+                out << "  Course: " << courseCode << "\n";
+                currentCourse = courseCode;
+            }
+            out << "    Exam: " << examType << " | Score: " << score << "\n";
+        });
+        if (first) {
+            out << "No exam scores recorded.\n";
+        }
+    }
+
+    void viewStudentFinalGrades() const {
+        StreamSink out(cout);
+        viewStudentFinalGrades(out);
+    }
+
+    void viewStudentFinalGrades(OutputSink& out) const {
+        vector<Gradebook::FinalGradeRow> rows = Gradebook::selectFinalGrades(*records->finalGradeSnapshot(), assignedCourses);
+        if (rows.empty()) {
+            out << "No final grades assigned.\n";
+            return;
+        }
+        out << "Final Grades for Assigned Courses:\n";
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (i == 0 || rows[i].studentId != rows[i - 1].studentId) {
+                out << "Student ID: " << rows[i].studentId << "\n";
+            }
+            out << "  Course: " << rows[i].courseCode << " | Final Grade: " << rows[i].grade << "\n";
+        }
+    }
+
+    void viewRosters() const {
+        StreamSink out(cout);
+        viewRosters(out);
+    }
+
+    void viewRosters(OutputSink& out) const {
+        if (assignedCourses.empty()) {
+            out << "No courses assigned.\n";
+            return;
+        }
+        for (CourseId course : assignedCourses) {
+            out << "Course: " << catalog->code(course) << " | Enrolled: " << enrollments->headcount(course) << "\n";
+            for (int studentId : enrollments->roster(course)) {
+                out << "  Student ID: " << studentId << "\n";
+            }
+        }
+    }
+
+    void viewExamAverages() const {
+        StreamSink out(cout);
+        viewExamAverages(out);
+    }
+
+    void viewExamAverages(OutputSink& out) const {
+        vector<Gradebook::ExamAverage> averages = records->examAverages(assignedCourses);
+        if (averages.empty()) {
+            out << "No exam scores recorded.\n";
+            return;
+        }
+        out << "Exam Averages:\n";
+        for (const auto& average : averages) {
+            out << "Course: " << average.courseCode << " | Exam: " << average.examType
+                << " | Mean: " << average.mean << " | Students: " << average.count << "\n";
+        }
+    }
+
+    void menu() override {
+        int choice;
+        do {
+            cout << "\nFaculty Menu\n";
+            cout << "1. Assign Course\n";
+            cout << "2. Record Attendance\n";
+            cout << "3. Record Exam Score\n";
+            cout << "4. Assign Final Grade\n";
+            cout << "5. View Student Attendance\n";
+            cout << "6. View Student Exam Scores\n";
+            cout << "7. View Student Final Grades\n";
+            cout << "8. View Exam Averages\n";
+            cout << "9. View Course Rosters\n";
+            cout << "10. Record Class Session\n";
+            cout << "11. Logout\n";
+            cout << "Enter your choice: ";
+            cin >> choice;
+
+            switch (choice) {
+                case 1: {
+                    string courseCode, courseName;
+                    cout << "Enter Course Code: ";
+                    cin >> courseCode;
+                    cin.ignore();
+                    cout << "Enter Course Name: ";
+                    getline(cin, courseName);
+                    assignCourse(courseCode, courseName);
+                    cout << "Course assigned successfully!\n";
+                    break;
+                }
+                case 2: {
+                    int studentId;
+                    string courseCode;
+                    int attendance;
+                    cout << "Enter Student ID: ";
+                    cin >> studentId;
+                    cout << "Enter Course Code: ";
+                    cin >> courseCode;
+                    cout << "Enter Attendance: ";
+                    cin >> attendance;
+                    recordAttendance(studentId, courseCode, attendance);
+                    break;
+                }
+                case 3: {
+                    int studentId;
+                    string courseCode, examType;
+                    float score;
+                    cout << "Enter Student ID: ";
+                    cin >> studentId;
+                    cout << "Enter Course Code: ";
+                    cin >> courseCode;
+                    cout << "Enter Exam Type: ";
+                    cin >> examType;
+                    cout << "Enter Score: ";
+                    cin >> score;
+                    recordExamScore(studentId, courseCode, examType, score);
+                    break;
+                }
+                case 4: {
+                    int studentId;
+                    string courseCode;
+                    float grade;
+                    cout << "Enter Student ID: ";
+                    cin >> studentId;
+                    cout << "Enter Course Code: ";
+                    cin >> courseCode;
+                    cout << "Enter Final Grade: ";
+                    cin >> grade;
+                    assignFinalGrade(studentId, courseCode, grade);
+                    break;
+                }
+                case 5:
+                    viewStudentAttendance();
+                    break;
+                case 6:
+                    viewStudentExamScores();
+                    break;
+                case 7:
+                    viewStudentFinalGrades();
+                    break;
+                case 8:
+                    viewExamAverages();
+                    break;
+                case 9:
+                    viewRosters();
+                    break;
+                case 10: {
+                    string courseCode, date;
+                    int studentId;
+                    vector<int> absent, present;
+                    cout << "Enter Course Code: ";
+                    cin >> courseCode;
+                    cout << "Enter Session Date (YYYY-MM-DD): ";
+                    cin >> date;
+                    cout << "Enter Student IDs of absentees (0 to finish): ";
+                    while (cin >> studentId && studentId != 0) {
+                        absent.push_back(studentId);
+                    }
+                    sort(absent.begin(), absent.end());
+                    CourseId course;
+                    if (catalog->find(courseCode, course)) {
+                        for (int enrolled : enrollments->roster(course)) {
+                            if (!binary_search(absent.begin(), absent.end(), enrolled)) {
+                                present.push_back(enrolled);
+                            }
+                        }
+                    }
+                    recordSession(courseCode, date, present);
+                    break;
+                }
+                case 11:
+                    cout << "Logging out...\n";
+                    break;
+                default:
+                    cout << "Invalid choice! Please try again.\n";
+            }
+        } while (choice != 11);
+    }
+};
+
+enum class DocKind : uint8_t { Notice, Event };
+
+struct SearchHit {
+    DocKind kind;
+    int id;
+    float score;
+};
+
+class SearchIndex {
+private:
+    static const uint32_t SKIP_INTERVAL = 128;
+
+    struct Skip {
+        uint32_t base;
+        uint32_t offset;
+    };
+
+    struct PostingList {
+        vector<uint8_t> bytes;
+        vector<Skip> skips;
+        uint32_t lastDoc = 0;
+        uint32_t count = 0;
+
+        void append(uint32_t doc, uint32_t tf) {
+            if (count % SKIP_INTERVAL == 0) {
+                skips.push_back({lastDoc, uint32_t(bytes.size())});
+            }
+            putVarint(bytes, doc - lastDoc);
+            putVarint(bytes, tf);
+            lastDoc = doc;
+            ++count;
+        }
+    };
+
+    class Cursor {
+    private:
+        const PostingList* list;
+        size_t pos;
+        size_t nextSkip;
+        uint32_t prev;
+
+    public:
+        uint32_t doc;
+        uint32_t tf;
+        bool done;
+
+        explicit Cursor(const PostingList* postings) : list(postings), pos(0), nextSkip(0), prev(0), doc(0), tf(0), done(false) {
+            next();
+        }
+
+        void next() {
+            if (pos >= list->bytes.size()) {
+                done = true;
+                return;
+            }
+            doc = prev + getVarint(list->bytes, pos);
+            tf = getVarint(list->bytes, pos);
+            prev = doc;
+            if (nextSkip < list->skips.size() && pos > list->skips[nextSkip].offset) {
+                ++nextSkip;
+            }
+        }
+
+        void advanceTo(uint32_t target) {
+            if (done || doc >= target) {
+                return;
+            }
+            const vector<Skip>& skips = list->skips;
+            if (nextSkip < skips.size() && skips[nextSkip].base < target) {
+                auto skip = upper_bound(skips.begin() + nextSkip, skips.end(), target,
+                                        [](uint32_t value, const Skip& s) { return value <= s.base; });
+                --skip;
+                pos = skip->offset;
+                prev = skip->base;
+                nextSkip = skip - skips.begin();
+            }
+            do {
+                next();
+            } while (!done && doc < target);
+        }
+    };
+
+    struct DocRef {
+        DocKind kind;
+        bool stale;
+        int id;
+    };
+
+    unordered_map<string, PostingList> terms;
+    vector<DocRef> docs;
+    unordered_map<uint64_t, uint32_t> docNumbers;
+    size_t staleDocs = 0;
+
+    static uint64_t docKey(DocKind kind, int id) {
+        return (uint64_t(kind) << 32) | uint32_t(id);
+    }
+
+    static void putVarint(vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(uint8_t(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(uint8_t(value));
+    }
+
+    static uint32_t getVarint(const vector<uint8_t>& in, size_t& pos) {
+        if (in[pos] < 0x80) {
+            return in[pos++];
+        }
+        uint32_t value = 0;
+        for (int shift = 0; pos < in.size(); shift += 7) {
+            uint8_t byte = in[pos++];
+            value |= uint32_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    static float termWeight(uint32_t tf) {
+        static const auto table = [] {
+            array<float, 32> weights{};
+            for (uint32_t i = 1; i < weights.size(); ++i) {
+                weights[i] = 1.0f + log(float(i));
+            }
+            return weights;
+        }();
+        return tf < table.size() ? table[tf] : 1.0f + log(float(tf));
+    }
+
+    void markStale(uint64_t key) {
+        auto it = docNumbers.find(key);
+        if (it == docNumbers.end()) {
+            return;
+        }
+        docs[it->second].stale = true;
+        docNumbers.erase(it);
+        ++staleDocs;
+        if (staleDocs > 1024 && staleDocs > docNumbers.size()) {
+            compact();
+        }
+    }
+
+    void compact() {
+        vector<uint32_t> renumber(docs.size());
+        vector<DocRef> live;
+        live.reserve(docNumbers.size());
+        for (uint32_t doc = 0; doc < docs.size(); ++doc) {
+            renumber[doc] = live.size();
+            if (!docs[doc].stale) {
+                live.push_back(docs[doc]);
+            }
+        }
+        for (auto it = terms.begin(); it != terms.end();) {
+            PostingList rebuilt;
+            for (Cursor cursor(&it->second); !cursor.done; cursor.next()) {
+                if (!docs[cursor.doc].stale) {
+                    rebuilt.append(renumber[cursor.doc], cursor.tf);
+                }
+            }
+            if (rebuilt.count == 0) {
+                it = terms.erase(it);
+            } else {
+                rebuilt.bytes.shrink_to_fit();
+                it->second = move(rebuilt);
+                ++it;
+            }
+        }
+        for (auto& entry : docNumbers) {
+            entry.second = renumber[entry.second];
+        }
+        docs.swap(live);
+        staleDocs = 0;
+    }
+
+public:
+    static vector<string> tokenize(const string& text) {
+        vector<string> tokens;
+        string token;
+        for (char c : text) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (isalnum(u)) {
+                token += char(tolower(u));
+            } else if (!token.empty()) {
+                tokens.push_back(move(token));
+                token.clear();
+            }
+        }
+        if (!token.empty()) {
+            tokens.push_back(move(token));
+        }
+        return tokens;
+    }
+
+    void index(DocKind kind, int id, const string& text) {
+        uint64_t key = docKey(kind, id);
+        markStale(key);
+        vector<string> tokens = tokenize(text);
+        sort(tokens.begin(), tokens.end());
+        uint32_t doc = docs.size();
+        docs.push_back({kind, false, id});
+        docNumbers[key] = doc;
+        for (size_t i = 0; i < tokens.size();) {
+            size_t j = i + 1;
+            while (j < tokens.size() && tokens[j] == tokens[i]) {
+                ++j;
+            }
+            terms[tokens[i]].append(doc, j - i);
+            i = j;
+        }
+    }
+
+    void remove(DocKind kind, int id) {
+        markStale(docKey(kind, id));
+    }
+
+    size_t documentCount() const { return docNumbers.size(); }
+
+    vector<SearchHit> search(const string& query, size_t limit) const {
+        vector<SearchHit> hits;
+        vector<string> words = tokenize(query);
+        sort(words.begin(), words.end());
+        words.erase(unique(words.begin(), words.end()), words.end());
+        if (words.empty() || limit == 0) {
+            return hits;
+        }
+        vector<const PostingList*> lists;
+        for (const auto& word : words) {
+            auto it = terms.find(word);
+            if (it == terms.end()) {
+                return hits;
+            }
+            lists.push_back(&it->second);
+        }
+        sort(lists.begin(), lists.end(), [](const PostingList* a, const PostingList* b) { return a->count < b->count; });
+        vector<float> idf;
+        vector<Cursor> cursors;
+        for (const PostingList* list : lists) {
+            idf.push_back(log(1.0f + float(docs.size()) / list->count));
+            cursors.emplace_back(list);
+        }
+
+        vector<pair<float, uint32_t>> top;
+        auto lower = [](const pair<float, uint32_t>& a, const pair<float, uint32_t>& b) { return a > b; };
+        Cursor& lead = cursors[0];
+        while (!lead.done) {
+            uint32_t candidate = lead.doc;
+            bool matched = true;
+            for (size_t i = 1; i < cursors.size(); ++i) {
+                cursors[i].advanceTo(candidate);
+                if (cursors[i].done) {
+                    lead.done = true;
+                    matched = false;
+                    break;
+                }
+                if (cursors[i].doc != candidate) {
+                    lead.advanceTo(cursors[i].doc);
+                    matched = false;
+                    break;
+                }
+            }
+            if (!matched) {
+                continue;
+            }
+            if (!docs[candidate].stale) {
+                float score = 0;
+                for (size_t i = 0; i < cursors.size(); ++i) {
+                    score += termWeight(cursors[i].tf) * idf[i];
+                }
+                if (top.size() < limit) {
+                    top.emplace_back(score, candidate);
+                    push_heap(top.begin(), top.end(), lower);
+                } else if (score > top.front().first) {
+                    pop_heap(top.begin(), top.end(), lower);
+                    top.back() = make_pair(score, candidate);
+                    push_heap(top.begin(), top.end(), lower);
+                }
+            }
+            lead.next();
+        }
+        sort(top.begin(), top.end(), greater<pair<float, uint32_t>>());
+        for (const auto& entry : top) {
+            const DocRef& ref = docs[entry.second];
+            hits.push_back({ref.kind, ref.id, entry.first});
+        }
+        return hits;
+    }
+};
+
+class Notice {
+public:
+    int id;
+    string message;
+    string category;
+    time_t timestamp;
+    bool deleted;
+
+    Notice(int noticeId, const string& msg, const string& cat)
+        : id(noticeId), message(msg), category(cat), timestamp(time(0)), deleted(false) {}
+
+    Notice(int noticeId, const string& msg, const string& cat, time_t ts)
+        : id(noticeId), message(msg), category(cat), timestamp(ts), deleted(false) {}
+
+    string getTimestamp() const {
+        return TimestampFormatter::format(timestamp);
+    }
+};
+
+class NoticeBoard {
+private:
+    // Keyed by (timestamp, slot) so a delete erases its own entry directly; slots break ties in insertion order.
+    using TimeIndex = set<pair<time_t, size_t>>;
+
+    vector<Notice> notices;
+    unordered_map<int, size_t> noticeIndex;
+    unordered_map<string, TimeIndex> byCategory;
+    TimeIndex byTime;
+    size_t tombstones;
+    int nextNoticeId;
+    WriteAheadLog* journal;
+    SearchIndex* searchIndex;
+    mutable PublishedView<vector<Notice>> published;
+
+    void indexText(const Notice& notice) {
+        if (searchIndex) {
+            searchIndex->index(DocKind::Notice, notice.id, notice.category + " " + notice.message);
+        }
+    }
+
+    void indexNotice(size_t slot) {
+        const Notice& notice = notices[slot];
+        noticeIndex[notice.id] = slot;
+        byCategory[notice.category].emplace(notice.timestamp, slot);
+        byTime.emplace(notice.timestamp, slot);
+    }
+
+    void insertNotice(Notice notice) {
+        notices.push_back(move(notice));
+        indexNotice(notices.size() - 1);
+        indexText(notices.back());
+        published.invalidate();
+    }
+
+    void compactNotices() {
+        vector<Notice> live;
+        live.reserve(noticeIndex.size());
+        for (auto& notice : notices) {
+            if (!notice.deleted) {
+                live.push_back(move(notice));
+            }
+        }
+        notices.swap(live);
+        noticeIndex.clear();
+        byCategory.clear();
+        byTime.clear();
+        tombstones = 0;
+        for (size_t slot = 0; slot < notices.size(); ++slot) {
+            indexNotice(slot);
+        }
+    }
+
+    Notice* findNotice(int id) {
+        auto it = noticeIndex.find(id);
+        return it == noticeIndex.end() ? nullptr : &notices[it->second];
+    }
+
+    void logNotice(const Notice& notice) const {
+        journal->append({"notice", to_string(notice.id), to_string(notice.timestamp), notice.category, notice.message});
+    }
+
+public:
+    static void printNotice(const Notice& notice, OutputSink& out) {
+        out << "Notice ID: " << notice.id << "\n";
+        out << "Message: " << notice.message << "\n";
+        out << "Category: " << notice.category << "\n";
+        out << "Timestamp: " << notice.getTimestamp() << "\n";
+        out << "-------------------------\n";
+    }
+
+    NoticeBoard() : tombstones(0), nextNoticeId(1), journal(nullptr), searchIndex(nullptr) {}
+
+    void setJournal(WriteAheadLog* log) { journal = log; }
+
+    void setSearchIndex(SearchIndex* index) { searchIndex = index; }
+
+    size_t recordCount() const { return noticeIndex.size(); }
+
+    const Notice* getNotice(int id) const {
+        auto it = noticeIndex.find(id);
+        return it == noticeIndex.end() ? nullptr : &notices[it->second];
+    }
+
+    int addNotice(const string& message, const string& category) {
+        insertNotice(Notice(nextNoticeId++, message, category));
+        if (journal) {
+            logNotice(notices.back());
+        }
+        cout << "Notice added successfully!\n";
+        return notices.back().id;
+    }
+
+    void restoreNotice(int id, time_t timestamp, const string& category, const string& message) {
+        if (noticeIndex.count(id)) {
+            return;
+        }
+        insertNotice(Notice(id, message, category, timestamp));
+        nextNoticeId = max(nextNoticeId, id + 1);
+    }
+
+    void restoreNextId(int nextId) {
+        nextNoticeId = max(nextNoticeId, nextId);
+    }
+
+    bool editNotice(int id, const string& newMessage) {
+        Notice* notice = findNotice(id);
+        if (!notice) {
+            cout << "Notice not found!\n";
+            return false;
+        }
+        notice->message = newMessage;
+        indexText(*notice);
+        published.invalidate();
+        if (journal) {
+            journal->append({"notice-edit", to_string(id), newMessage});
+        }
+        cout << "Notice updated successfully!\n";
+        return true;
+    }
+
+    bool deleteNotice(int id) {
+        auto it = noticeIndex.find(id);
+        if (it == noticeIndex.end()) {
+            cout << "Notice not found!\n";
+            return false;
+        }
+        size_t slot = it->second;
+        Notice& notice = notices[slot];
+        auto category = byCategory.find(notice.category);
+        category->second.erase({notice.timestamp, slot});
+        if (category->second.empty()) {
+            byCategory.erase(category);
+        }
+        byTime.erase({notice.timestamp, slot});
+        noticeIndex.erase(it);
+        if (searchIndex) {
+            searchIndex->remove(DocKind::Notice, id);
+        }
+        notice.deleted = true;
+        notice.message.clear();
+        published.invalidate();
+        ++tombstones;
+        if (journal) {
+            journal->append({"notice-delete", to_string(id)});
+        }
+        if (tombstones > 64 && tombstones > noticeIndex.size()) {
+            compactNotices();
+        }
+        cout << "Notice deleted successfully!\n";
+        return true;
+    }
+
+    vector<const Notice*> noticesSince(const string& category, time_t since) const {
+        vector<const Notice*> result;
+        auto it = byCategory.find(category);
+        if (it == byCategory.end()) {
+            return result;
+        }
+        for (auto entry = it->second.lower_bound({since, 0}); entry != it->second.end(); ++entry) {
+            result.push_back(&notices[entry->second]);
+        }
+        return result;
+    }
+
+    vector<const Notice*> latestNotices(size_t count) const {
+        vector<const Notice*> result;
+        for (auto entry = byTime.rbegin(); entry != byTime.rend() && result.size() < count; ++entry) {
+            result.push_back(&notices[entry->second]);
+        }
+        return result;
+    }
+
+    void writeState(ostream& out) const {
+        WriteAheadLog::writeRecord(out, {"notice-seq", to_string(nextNoticeId)});
+        for (const auto& notice : notices) {
+            if (!notice.deleted) {
+                WriteAheadLog::writeRecord(out, {"notice", to_string(notice.id), to_string(notice.timestamp), notice.category, notice.message});
+            }
+        }
+    }
+
+    shared_ptr<const vector<Notice>> snapshot() const {
+        return published.get([this](vector<Notice>& view) {
+            view.reserve(noticeIndex.size());
+            for (const auto& notice : notices) {
+                if (!notice.deleted) {
+                    view.push_back(notice);
+                }
+            }
+        });
+    }
+
+    void viewNotices() const {
+        StreamSink out(cout);
+        viewNotices(out);
+    }
+
+    void viewNotices(OutputSink& out) const {
+        shared_ptr<const vector<Notice>> view = snapshot();
+        if (view->empty()) {
+            out << "No notices available.\n";
+            return;
+        }
+        out << "Notice Board:\n";
+        for (const auto& notice : *view) {
+            printNotice(notice, out);
+        }
+    }
+
+    void viewNotices(const vector<const Notice*>& selection) const {
+        StreamSink out(cout);
+        viewNotices(selection, out);
+    }
+
+    void viewNotices(const vector<const Notice*>& selection, OutputSink& out) const {
+        if (selection.empty()) {
+            out << "No matching notices.\n";
+            return;
+        }
+        for (const Notice* notice : selection) {
+            printNotice(*notice, out);
+        }
+    }
+};
+
+inline unsigned lowestSetBit(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    unsigned bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+class Library {
+private:
+    struct Title {
+        string name;
+        string isbn;
+        vector<uint64_t> owned;
+        vector<uint64_t> available;
+        uint32_t ownedCount = 0;
+        uint32_t availableCount = 0;
+        size_t freeHint = 0;
+    };
+
+    struct Loan {
+        uint32_t title;
+        uint32_t copy;
+    };
+
+    vector<Title> titles;
+    unordered_map<string, uint32_t> titleIndex;
+    unordered_map<string, uint32_t> isbnIndex;
+    unordered_map<string, vector<Loan>> loans;
+    size_t volumes;
+    size_t onLoan;
+    WriteAheadLog* journal;
+
+public:
+    struct BookLine {
+        string name;
+        string isbn;
+        uint32_t available;
+        uint32_t owned;
+    };
+
+private:
+    mutable PublishedView<vector<BookLine>> published;
+
+    static bool testBit(const vector<uint64_t>& bits, uint32_t copy) {
+        return (bits[copy / 64] >> (copy % 64)) & 1;
+    }
+
+    static void setBit(vector<uint64_t>& bits, uint32_t copy) {
+        bits[copy / 64] |= uint64_t(1) << (copy % 64);
+    }
+
+    static void clearBit(vector<uint64_t>& bits, uint32_t copy) {
+        bits[copy / 64] &= ~(uint64_t(1) << (copy % 64));
+    }
+
+    Title* findTitle(const string& book) {
+        auto it = titleIndex.find(book);
+        if (it == titleIndex.end()) {
+            it = isbnIndex.find(book);
+            if (it == isbnIndex.end()) {
+                return nullptr;
+            }
+        }
+        return &titles[it->second];
+    }
+
+    uint32_t takeAvailableCopy(Title& title) {
+        size_t word = title.freeHint;
+        while (title.available[word] == 0) {
+            ++word;
+        }
+        title.freeHint = word;
+        uint32_t copy = word * 64 + lowestSetBit(title.available[word]);
+        clearBit(title.available, copy);
+        --title.availableCount;
+        published.invalidate();
+        return copy;
+    }
+
+    void releaseCopy(Title& title, uint32_t copy) {
+        setBit(title.available, copy);
+        ++title.availableCount;
+        published.invalidate();
+        title.freeHint = min(title.freeHint, size_t(copy / 64));
+    }
+
+public:
+    Library() : volumes(0), onLoan(0), journal(nullptr) {}
+
+    void setJournal(WriteAheadLog* log) { journal = log; }
+
+    bool addBook(const string& book, const string& isbn = "") {
+        if (!isbn.empty()) {
+            auto owner = isbnIndex.find(isbn);
+            if (owner != isbnIndex.end() && titles[owner->second].name != book) {
+                cout << "ISBN " << isbn << " already belongs to " << titles[owner->second].name << "!\n";
+                return false;
+            }
+        }
+        auto it = titleIndex.find(book);
+        if (it == titleIndex.end()) {
+            it = titleIndex.emplace(book, titles.size()).first;
+            titles.emplace_back();
+            titles.back().name = book;
+        }
+        Title& title = titles[it->second];
+        if (!isbn.empty() && title.isbn.empty()) {
+            title.isbn = isbn;
+            isbnIndex.emplace(isbn, it->second);
+        }
+        uint32_t copy = 0;
+        size_t word = 0;
+        while (word < title.owned.size() && title.owned[word] == ~uint64_t(0)) {
+            ++word;
+        }
+        if (word == title.owned.size()) {
+            title.owned.push_back(0);
+            title.available.push_back(0);
+        }
+        copy = word * 64 + lowestSetBit(~title.owned[word]);
+        setBit(title.owned, copy);
+        ++title.ownedCount;
+        ++volumes;
+        releaseCopy(title, copy);
+        if (journal) {
+            if (title.isbn.empty()) {
+                journal->append({"book", book});
+            } else {
+                journal->append({"book", book, title.isbn});
+            }
+        }
+        cout << "Book added successfully!\n";
+        return true;
+    }
+
+    bool removeBook(const string& book) {
+        Title* title = findTitle(book);
+        if (!title || title->availableCount == 0) {
+            cout << "Book not found!\n";
+            return false;
+        }
+        uint32_t copy = takeAvailableCopy(*title);
+        clearBit(title->owned, copy);
+        --title->ownedCount;
+        --volumes;
+        if (journal) {
+            journal->append({"book-remove", title->name});
+        }
+        cout << "Book removed successfully!\n";
+        return true;
+    }
+
+    bool checkOutBook(const string& book, const string& borrower) {
+        Title* title = findTitle(book);
+        if (!title || title->availableCount == 0) {
+            cout << "Book not found!\n";
+            return false;
+        }
+        uint32_t copy = takeAvailableCopy(*title);
+        loans[borrower].push_back({uint32_t(title - titles.data()), copy});
+        ++onLoan;
+        cout << "Book checked out to " << borrower << " successfully!\n";
+        if (journal) {
+            journal->append({"book-checkout", title->name, borrower});
+        }
+        return true;
+    }
+
+    bool returnBook(const string& book, const string& borrower) {
+        Title* title = findTitle(book);
+        auto it = loans.find(borrower);
+        if (title && it != loans.end()) {
+            uint32_t index = title - titles.data();
+            vector<Loan>& held = it->second;
+            for (size_t i = 0; i < held.size(); ++i) {
+                if (held[i].title == index) {
+                    releaseCopy(*title, held[i].copy);
+                    held[i] = held.back();
+                    held.pop_back();
+                    --onLoan;
+                    if (held.empty()) {
+                        loans.erase(it);
+                    }
+                    if (journal) {
+                        journal->append({"book-return", title->name, borrower});
+                    }
+                    cout << "Book returned by " << borrower << " successfully!\n";
+                    return true;
+                }
+            }
+        }
+        cout << borrower << " has no loan of " << book << "!\n";
+        return false;
+    }
+
+    vector<string> loansOf(const string& borrower) const {
+        vector<string> result;
+        auto it = loans.find(borrower);
+        if (it != loans.end()) {
+            for (const Loan& loan : it->second) {
+                result.push_back(titles[loan.title].name);
+            }
+        }
+        return result;
+    }
+
+    size_t volumeCount() const { return volumes; }
+
+    size_t recordCount() const { return volumes + onLoan; }
+
+    void writeState(ostream& out) const {
+        for (const auto& title : titles) {
+            for (uint32_t copy = 0; copy < title.ownedCount; ++copy) {
+                if (title.isbn.empty()) {
+                    WriteAheadLog::writeRecord(out, {"book", title.name});
+                } else {
+                    WriteAheadLog::writeRecord(out, {"book", title.name, title.isbn});
+                }
+            }
+        }
+        for (const auto& entry : loans) {
+            for (const Loan& loan : entry.second) {
+                WriteAheadLog::writeRecord(out, {"book-checkout", titles[loan.title].name, entry.first});
+            }
+        }
+    }
+
+    shared_ptr<const vector<BookLine>> snapshot() const {
+        return published.get([this](vector<BookLine>& view) {
+            for (const auto& title : titles) {
+                if (title.ownedCount > 0) {
+                    view.push_back({title.name, title.isbn, title.availableCount, title.ownedCount});
+                }
+            }
+        });
+    }
+
+    void viewBooks() const {
+        StreamSink out(cout);
+        viewBooks(out);
+    }
+
+    void viewBooks(OutputSink& out) const {
+        shared_ptr<const vector<BookLine>> view = snapshot();
+        bool any = false;
+        for (const auto& book : *view) {
+            if (book.available == 0) {
+                continue;
+            }
+            if (!any) {
+                out << "Available Books:\n";
+                any = true;
+            }
+            out << book.name;
+            if (!book.isbn.empty()) {
+                out << " (ISBN " << book.isbn << ")";
+            }
+            out << " - " << book.available << " of " << book.owned << " copies available\n";
+        }
+        if (!any) {
+            out << "No books available.\n";
+        }
+    }
+
+    void viewLoans(const string& borrower) const {
+        StreamSink out(cout);
+        viewLoans(borrower, out);
+    }
+
+    void viewLoans(const string& borrower, OutputSink& out) const {
+        vector<string> held = loansOf(borrower);
+        if (held.empty()) {
+            out << borrower << " has no books checked out.\n";
+            return;
+        }
+        out << "Books checked out to " << borrower << ":\n";
+        for (const auto& book : held) {
+            out << book << "\n";
+        }
+    }
+};
+
+class FreeBitmap {
+private:
+    vector<vector<uint64_t>> levels;
+    size_t bits;
+
+public:
+    static const size_t NONE = SIZE_MAX;
+
+    FreeBitmap() : levels(1), bits(0) {}
+
+    size_t size() const { return bits; }
+
+    // New bits start clear, so growing only extends each level; a new top level inherits the old top's state.
+    void grow(size_t count) {
+        if (count <= bits) {
+            return;
+        }
+        bits = count;
+        size_t words = (count + 63) / 64;
+        levels[0].resize(words, 0);
+        for (size_t level = 1; words > 1; ++level) {
+            words = (words + 63) / 64;
+            if (level == levels.size()) {
+                levels.emplace_back(words, 0);
+                levels[level][0] = levels[level - 1][0] != 0;
+            } else {
+                levels[level].resize(words, 0);
+            }
+        }
+    }
+
+    bool test(size_t index) const {
+        return (levels[0][index / 64] >> (index % 64)) & 1;
+    }
+
+    void set(size_t index) {
+        for (auto& level : levels) {
+            uint64_t& word = level[index / 64];
+            bool wasEmpty = word == 0;
+            word |= uint64_t(1) << (index % 64);
+            if (!wasEmpty) {
+                return;
+            }
+            index /= 64;
+        }
+    }
+
+    void clear(size_t index) {
+        for (auto& level : levels) {
+            uint64_t& word = level[index / 64];
+            word &= ~(uint64_t(1) << (index % 64));
+            if (word != 0) {
+                return;
+            }
+            index /= 64;
+        }
+    }
+
+    size_t findFirst() const {
+        if (levels.back().empty() || levels.back()[0] == 0) {
+            return NONE;
+        }
+        size_t index = 0;
+        for (size_t level = levels.size(); level-- > 0;) {
+            index = index * 64 + lowestSetBit(levels[level][index]);
+        }
+        return index;
+    }
+
+    size_t findFirstInRange(size_t from, size_t to) const {
+        const vector<uint64_t>& leaves = levels[0];
+        for (size_t word = from / 64; word * 64 < to; ++word) {
+            uint64_t candidates = leaves[word];
+            if (word == from / 64) {
+                candidates &= ~uint64_t(0) << (from % 64);
+            }
+            if (candidates) {
+                size_t index = word * 64 + lowestSetBit(candidates);
+                return index < to ? index : NONE;
+            }
+        }
+        return NONE;
+    }
+};
+
+class Hostel {
+private:
+    struct Room {
+        string name;
+        uint32_t firstBed;
+        uint32_t capacity;
+        uint32_t occupied;
+    };
+
+    vector<Room> rooms;
+    unordered_map<string, uint32_t> roomIndex;
+    vector<uint32_t> bedRoom;
+    vector<string> bedOccupant;
+    FreeBitmap freeBeds;
+    unordered_map<string, uint32_t> studentBed;
+    WriteAheadLog* journal;
+
+public:
+    struct RoomLine {
+        string name;
+        uint32_t freeBeds;
+        uint32_t capacity;
+    };
+
+    struct HostelView {
+        vector<RoomLine> availableRooms;
+        vector<pair<string, string>> assignments;
+    };
+
+private:
+    mutable PublishedView<HostelView> published;
+
+    void occupy(uint32_t bed, const string& student) {
+        Room& room = rooms[bedRoom[bed]];
+        freeBeds.clear(bed);
+        bedOccupant[bed] = student;
+        studentBed[student] = bed;
+        ++room.occupied;
+        published.invalidate();
+        if (journal) {
+            journal->append({"room-assign", room.name, student});
+        }
+    }
+
+public:
+    Hostel() : journal(nullptr) {}
+
+    void setJournal(WriteAheadLog* log) { journal = log; }
+
+    size_t recordCount() const { return rooms.size() + studentBed.size(); }
+
+    bool addRoom(const string& room, uint32_t capacity = 1) {
+        if (capacity == 0 || roomIndex.count(room)) {
+            cout << "Room already exists or has no beds!\n";
+            return false;
+        }
+        uint32_t firstBed = bedRoom.size();
+        roomIndex.emplace(room, rooms.size());
+        rooms.push_back({room, firstBed, capacity, 0});
+        bedRoom.resize(firstBed + capacity, rooms.size() - 1);
+        bedOccupant.resize(firstBed + capacity);
+        freeBeds.grow(firstBed + capacity);
+        for (uint32_t bed = firstBed; bed < firstBed + capacity; ++bed) {
+            freeBeds.set(bed);
+        }
+        published.invalidate();
+        if (journal) {
+            journal->append({"room", room, to_string(capacity)});
+        }
+        cout << "Room added successfully!\n";
+        return true;
+    }
+
+    bool assignRoom(const string& room, const string& student) {
+        auto it = roomIndex.find(room);
+        if (it == roomIndex.end()) {
+            cout << "Room not found!\n";
+            return false;
+        }
+        if (studentBed.count(student)) {
+            cout << student << " already has a room!\n";
+            return false;
+        }
+        const Room& target = rooms[it->second];
+        size_t bed = freeBeds.findFirstInRange(target.firstBed, target.firstBed + target.capacity);
+        if (bed == FreeBitmap::NONE) {
+            cout << "Room " << room << " is full!\n";
+            return false;
+        }
+        occupy(bed, student);
+        cout << "Room assigned to " << student << " successfully!\n";
+        return true;
+    }
+
+    bool firstFreeBed(string& room, uint32_t& bedNumber) const {
+        size_t bed = freeBeds.findFirst();
+        if (bed == FreeBitmap::NONE) {
+            return false;
+        }
+        const Room& owner = rooms[bedRoom[bed]];
+        room = owner.name;
+        bedNumber = bed - owner.firstBed + 1;
+        return true;
+    }
+
+    size_t autoAssign(const vector<string>& students) {
+        size_t placed = 0;
+        size_t bed = freeBeds.findFirst();
+        for (const auto& student : students) {
+            if (bed == FreeBitmap::NONE) {
+                break;
+            }
+            if (studentBed.count(student)) {
+                continue;
+            }
+            occupy(bed, student);
+            ++placed;
+            bed = freeBeds.findFirstInRange(bed + 1, freeBeds.size());
+        }
+        cout << placed << " students assigned to rooms.\n";
+        return placed;
+    }
+
+    void writeState(ostream& out) const {
+        for (const auto& room : rooms) {
+            WriteAheadLog::writeRecord(out, {"room", room.name, to_string(room.capacity)});
+        }
+        for (uint32_t bed = 0; bed < bedOccupant.size(); ++bed) {
+            if (!freeBeds.test(bed)) {
+                WriteAheadLog::writeRecord(out, {"room-assign", rooms[bedRoom[bed]].name, bedOccupant[bed]});
+            }
+        }
+    }
+
+    shared_ptr<const HostelView> snapshot() const {
+        return published.get([this](HostelView& view) {
+            for (const auto& room : rooms) {
+                if (room.occupied < room.capacity) {
+                    view.availableRooms.push_back({room.name, room.capacity - room.occupied, room.capacity});
+                }
+            }
+            view.assignments.reserve(studentBed.size());
+            for (uint32_t bed = 0; bed < bedOccupant.size(); ++bed) {
+                if (!freeBeds.test(bed)) {
+                    view.assignments.emplace_back(rooms[bedRoom[bed]].name, bedOccupant[bed]);
+                }
+            }
+        });
+    }
+
+    void viewRooms() const {
+        StreamSink out(cout);
+        viewRooms(out);
+    }
+
+    void viewRooms(OutputSink& out) const {
+        shared_ptr<const HostelView> view = snapshot();
+        if (view->availableRooms.empty()) {
+            out << "No rooms available.\n";
+            return;
+        }
+        out << "Available Rooms:\n";
+        for (const auto& room : view->availableRooms) {
+            out << room.name << " (" << room.freeBeds << " of " << room.capacity << " beds free)\n";
+        }
+    }
+
+    void viewRoomAssignments() const {
+        StreamSink out(cout);
+        viewRoomAssignments(out);
+    }
+
+    void viewRoomAssignments(OutputSink& out) const {
+        shared_ptr<const HostelView> view = snapshot();
+        if (view->assignments.empty()) {
+            out << "No room assignments available.\n";
+            return;
+        }
+        out << "Room Assignments:\n";
+        for (const auto& assignment : view->assignments) {
+            out << "Room: " << assignment.first << ", Student: " << assignment.second << "\n";
+        }
+    }
+};
+
+inline bool parseLocalTime(const string& date, const string& clock, time_t& out) {
+    struct tm local = {};
+    char extra;
+    if (sscanf(date.c_str(), "%d-%d-%d%c", &local.tm_year, &local.tm_mon, &local.tm_mday, &extra) != 3
+        || local.tm_mon < 1 || local.tm_mon > 12 || local.tm_mday < 1 || local.tm_mday > 31) {
+        return false;
+    }
+    if (sscanf(clock.c_str(), "%d:%d%c", &local.tm_hour, &local.tm_min, &extra) != 2
+        || local.tm_hour < 0 || local.tm_hour > 23 || local.tm_min < 0 || local.tm_min > 59) {
+        return false;
+    }
+    local.tm_year -= 1900;
+    local.tm_mon -= 1;
+    local.tm_isdst = -1;
+    struct tm parsed = local;
+    out = mktime(&local);
+    // mktime quietly rolls Feb 31 into March and skipped DST clock times forward; those inputs do not exist.
+    return out != time_t(-1) && local.tm_year == parsed.tm_year && local.tm_mon == parsed.tm_mon
+        && local.tm_mday == parsed.tm_mday && local.tm_hour == parsed.tm_hour && local.tm_min == parsed.tm_min;
+}
+
+class Event {
+public:
+    int id;
+    string name;
+    string description;
+    string date;
+    string time;
+    string location;
+    int duration;
+    time_t start;
+    bool scheduled;
+
+    Event(int eventId, const string& name, const string& description, const string& date, const string& time, const string& location, int duration = 60) 
+        : id(eventId), name(name), description(description), date(date), time(time), location(location), duration(duration), start(0), scheduled(false) {}
+
+    time_t end() const { return start + time_t(duration) * 60; }
+
+    void displayEvent(OutputSink& out) const {
+        out << "Event ID: " << id << "\n";
+        out << "Event Name: " << name << "\n";
+        out << "Event Description: " << description << "\n";
+        out << "Event Date: " << date << "\n";
+        out << "Event Time: " << time << "\n";
+        out << "Event Duration: " << duration << " minutes\n";
+        out << "Event Location: " << location << "\n";
+        if (!scheduled) {
+            out << "Note: not on the venue calendar (unparsed time or overlapping booking)\n";
+        }
+    }
+};
+
+class EventManagementSystem {
+private:
+    map<int, Event> events;
+    unordered_map<string, map<time_t, int>> venues;
+    multimap<time_t, int> byStart;
+    int maxDuration;
+    int nextEventId;
+    WriteAheadLog* journal;
+    SearchIndex* searchIndex;
+    mutable PublishedView<vector<Event>> published;
+
+    void indexText(const Event& event) {
+        published.invalidate();
+        if (searchIndex) {
+            searchIndex->index(DocKind::Event, event.id, event.name + " " + event.description + " " + event.location);
+        }
+    }
+
+    void logEvent(const char* type, const Event& event) const {
+        journal->append({type, to_string(event.id), event.name, event.description, event.date, event.time, event.location, to_string(event.duration)});
+    }
+
+    int conflictAt(const string& location, time_t start, time_t end, int ignoreId) const {
+        auto venue = venues.find(location);
+        if (venue == venues.end()) {
+            return 0;
+        }
+        auto it = venue->second.lower_bound(end);
+        while (it != venue->second.begin()) {
+            --it;
+            if (it->second == ignoreId) {
+                continue;
+            }
+            return events.at(it->second).end() > start ? it->second : 0;
+        }
+        return 0;
+    }
+
+    bool schedule(Event& event, int ignoreId) {
+        event.scheduled = false;
+        if (event.duration <= 0 || !parseLocalTime(event.date, event.time, event.start)
+            || conflictAt(event.location, event.start, event.end(), ignoreId)) {
+            return false;
+        }
+        venues[event.location].emplace(event.start, event.id);
+        byStart.emplace(event.start, event.id);
+        maxDuration = max(maxDuration, event.duration);
+        event.scheduled = true;
+        return true;
+    }
+
+    void unschedule(const Event& event) {
+        if (!event.scheduled) {
+            return;
+        }
+        auto venue = venues.find(event.location);
+        venue->second.erase(event.start);
+        if (venue->second.empty()) {
+            venues.erase(venue);
+        }
+        auto range = byStart.equal_range(event.start);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == event.id) {
+                byStart.erase(it);
+                break;
+            }
+        }
+    }
+
+    bool reportRejection(const string& date, const string& time, const string& location, int duration, int ignoreId) const {
+        time_t start;
+        if (duration <= 0 || !parseLocalTime(date, time, start)) {
+            cout << "Invalid event date, time or duration! Use YYYY-MM-DD, HH:MM and minutes.\n";
+            return false;
+        }
+        int conflict = conflictAt(location, start, start + time_t(duration) * 60, ignoreId);
+        if (conflict) {
+            cout << "Venue " << location << " is already booked by event " << conflict << " at that time!\n";
+            return false;
+        }
+        return true;
+    }
+
+public:
+    EventManagementSystem() : maxDuration(0), nextEventId(1), journal(nullptr), searchIndex(nullptr) {}
+
+    void setJournal(WriteAheadLog* log) { journal = log; }
+
+    void setSearchIndex(SearchIndex* index) { searchIndex = index; }
+
+    size_t recordCount() const { return events.size(); }
+
+    const Event* getEvent(int id) const {
+        auto it = events.find(id);
+        return it == events.end() ? nullptr : &it->second;
+    }
+
+    int addEvent(const string& name, const string& description, const string& date, const string& time, const string& location, int duration = 60) {
+        if (!reportRejection(date, time, location, duration, 0)) {
+            return 0;
+        }
+        Event& event = events.emplace(nextEventId, Event(nextEventId, name, description, date, time, location, duration)).first->second;
+        ++nextEventId;
+        schedule(event, 0);
+        indexText(event);
+        if (journal) {
+            logEvent("event", event);
+        }
+        cout << "Event added successfully!\n";
+        return event.id;
+    }
+
+    void restoreEvent(int id, const string& name, const string& description, const string& date, const string& time, const string& location, int duration = 60) {
+        auto inserted = events.emplace(id, Event(id, name, description, date, time, location, duration));
+        if (!inserted.second) {
+            return;
+        }
+        schedule(inserted.first->second, 0);
+        indexText(inserted.first->second);
+        nextEventId = max(nextEventId, id + 1);
+    }
+
+    void restoreNextId(int nextId) {
+        nextEventId = max(nextEventId, nextId);
+    }
+
+    bool editEvent(int id, const string& newName, const string& newDescription, const string& newDate, const string& newTime, const string& newLocation, int newDuration = 60) {
+        auto it = events.find(id);
+        if (it == events.end()) {
+            cout << "Event not found!\n";
+            return false;
+        }
+        if (!reportRejection(newDate, newTime, newLocation, newDuration, id)) {
+            return false;
+        }
+        Event& event = it->second;
+        unschedule(event);
+        event.name = newName;
+        event.description = newDescription;
+        event.date = newDate;
+        event.time = newTime;
+        event.location = newLocation;
+        event.duration = newDuration;
+        schedule(event, id);
+        indexText(event);
+        if (journal) {
+            logEvent("event-edit", event);
+        }
+        cout << "Event updated successfully!\n";
+        return true;
+    }
+
+    bool deleteEvent(int id) {
+        auto it = events.find(id);
+        if (it == events.end()) {
+            cout << "Event not found!\n";
+            return false;
+        }
+        unschedule(it->second);
+        events.erase(it);
+        published.invalidate();
+        if (searchIndex) {
+            searchIndex->remove(DocKind::Event, id);
+        }
+        if (journal) {
+            journal->append({"event-delete", to_string(id)});
+        }
+        cout << "Event deleted successfully!\n";
+        return true;
+    }
+
+    int venueConflict(const string& location, time_t start, int duration) const {
+        return conflictAt(location, start, start + time_t(duration) * 60, 0);
+    }
+
+    vector<const Event*> eventsInWindow(time_t from, time_t to) const {
+        vector<const Event*> result;
+        auto last = byStart.lower_bound(to);
+        for (auto it = byStart.lower_bound(from - time_t(maxDuration) * 60); it != last; ++it) {
+            const Event& event = events.at(it->second);
+            if (event.end() > from) {
+                result.push_back(&event);
+            }
+        }
+        return result;
+    }
+
+    vector<const Event*> upcomingEvents(time_t from, size_t count) const {
+        vector<const Event*> result;
+        for (auto it = byStart.lower_bound(from); it != byStart.end() && result.size() < count; ++it) {
+            result.push_back(&events.at(it->second));
+        }
+        return result;
+    }
+
+    shared_ptr<const vector<Event>> snapshot() const {
+        return published.get([this](vector<Event>& view) {
+            view.reserve(events.size());
+            for (const auto& entry : events) {
+                view.push_back(entry.second);
+            }
+        });
+    }
+
+    void viewEvents() const {
+        StreamSink out(cout);
+        viewEvents(out);
+    }
+
+    void viewEvents(OutputSink& out) const {
+        shared_ptr<const vector<Event>> view = snapshot();
+        if (view->empty()) {
+            out << "No events available.\n";
+            return;
+        }
+        out << "Events:\n";
+        for (const auto& event : *view) {
+            event.displayEvent(out);
+            out << "-------------------------\n";
+        }
+    }
+
+    void viewEvents(const vector<const Event*>& selection) const {
+        StreamSink out(cout);
+        viewEvents(selection, out);
+    }
+
+    void viewEvents(const vector<const Event*>& selection, OutputSink& out) const {
+        if (selection.empty()) {
+            out << "No matching events.\n";
+            return;
+        }
+        for (const Event* event : selection) {
+            event->displayEvent(out);
+            out << "-------------------------\n";
+        }
+    }
+
+    void writeState(ostream& out) const {
+        WriteAheadLog::writeRecord(out, {"event-seq", to_string(nextEventId)});
+        for (const auto& entry : events) {
+            const Event& event = entry.second;
+            WriteAheadLog::writeRecord(out, {"event", to_string(event.id), event.name, event.description, event.date, event.time, event.location, to_string(event.duration)});
+        }
+    }
+};
+
+struct SnapshotString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t generation;
+    uint32_t studentCount;
+    uint32_t facultyCount;
+    uint32_t poolSize;
+    uint32_t stateSize;
+};
+
+struct StudentRecord {
+    SnapshotString username;
+    SnapshotString password;
+    SnapshotString course;
+    int32_t id;
+    int32_t age;
+    int64_t feeCents;
+};
+
+struct FacultyRecord {
+    SnapshotString username;
+    SnapshotString password;
+};
+
+class SnapshotFile {
+private:
+    const char* data;
+    size_t size;
+    bool mapped;
+    vector<char> buffer;
+
+public:
+    static const uint32_t VERSION = 3;
+
+    SnapshotFile() : data(nullptr), size(0), mapped(false) {}
+
+    ~SnapshotFile() {
+#ifndef _WIN32
+        if (mapped) {
+            munmap(const_cast<char*>(data), size);
+        }
+#endif
+    }
+
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    bool open(const string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                data = static_cast<const char*>(addr);
+                size = st.st_size;
+                mapped = true;
+            }
+        }
+        ::close(fd);
+        return mapped && isValid();
+#else
+        ifstream inFile(path, ios::binary | ios::ate);
+        if (!inFile) {
+            return false;
+        }
+        buffer.resize(inFile.tellg());
+        inFile.seekg(0);
+        inFile.read(buffer.data(), buffer.size());
+        data = buffer.data();
+        size = buffer.size();
+        return inFile && isValid();
+#endif
+    }
+
+    bool isValid() const {
+        if (size < sizeof(SnapshotHeader)) {
+            return false;
+        }
+        const SnapshotHeader& h = header();
+        if (memcmp(h.magic, "SISB", 4) != 0 || h.version != VERSION) {
+            return false;
+        }
+        uint64_t expected = sizeof(SnapshotHeader)
+                          + uint64_t(h.studentCount) * sizeof(StudentRecord)
+                          + uint64_t(h.facultyCount) * sizeof(FacultyRecord)
+                          + h.poolSize
+                          + h.stateSize;
+        return expected == size;
+    }
+
+    const SnapshotHeader& header() const {
+        return *reinterpret_cast<const SnapshotHeader*>(data);
+    }
+
+    // The 28-byte header leaves the record arrays unaligned for int64_t, so records are copied out rather than cast.
+    StudentRecord student(uint32_t index) const {
+        StudentRecord record;
+        memcpy(&record, data + sizeof(SnapshotHeader) + size_t(index) * sizeof(StudentRecord), sizeof(record));
+        return record;
+    }
+
+    FacultyRecord faculty(uint32_t index) const {
+        FacultyRecord record;
+        memcpy(&record, data + sizeof(SnapshotHeader) + size_t(header().studentCount) * sizeof(StudentRecord)
+                            + size_t(index) * sizeof(FacultyRecord), sizeof(record));
+        return record;
+    }
+
+    const char* pool() const {
+        return data + sizeof(SnapshotHeader) + size_t(header().studentCount) * sizeof(StudentRecord)
+             + size_t(header().facultyCount) * sizeof(FacultyRecord);
+    }
+
+    bool getString(const SnapshotString& ref, string& out) const {
+        if (uint64_t(ref.offset) + ref.length > header().poolSize) {
+            return false;
+        }
+        out.assign(pool() + ref.offset, ref.length);
+        return true;
+    }
+
+    string state() const {
+        return string(pool() + header().poolSize, header().stateSize);
+    }
+};
+
+class SnapshotWriter {
+private:
+    vector<StudentRecord> studentRecords;
+    vector<FacultyRecord> facultyRecords;
+    string pool;
+    string state;
+    uint32_t generation;
+
+    SnapshotString intern(const string& value) {
+        SnapshotString ref = { uint32_t(pool.size()), uint32_t(value.size()) };
+        pool += value;
+        return ref;
+    }
+
+public:
+    explicit SnapshotWriter(uint32_t gen) : generation(gen) {}
+
+    void setState(const string& records) { state = records; }
+
+    void addStudent(const string& username, const string& password, const string& course, int id, int age, Cents fee) {
+        StudentRecord record;
+        record.username = intern(username);
+        record.password = intern(password);
+        record.course = intern(course);
+        record.id = id;
+        record.age = age;
+        record.feeCents = fee;
+        studentRecords.push_back(record);
+    }
+
+    void addFaculty(const string& username, const string& password) {
+        FacultyRecord record;
+        record.username = intern(username);
+        record.password = intern(password);
+        facultyRecords.push_back(record);
+    }
+
+    bool write(const string& path) const {
+        string tempPath = path + ".tmp";
+        SnapshotHeader h = {};
+        memcpy(h.magic, "SISB", 4);
+        h.version = SnapshotFile::VERSION;
+        h.generation = generation;
+        h.studentCount = studentRecords.size();
+        h.facultyCount = facultyRecords.size();
+        h.poolSize = pool.size();
+        h.stateSize = state.size();
+        const pair<const char*, size_t> parts[] = {
+            {reinterpret_cast<const char*>(&h), sizeof(h)},
+            {reinterpret_cast<const char*>(studentRecords.data()), studentRecords.size() * sizeof(StudentRecord)},
+            {reinterpret_cast<const char*>(facultyRecords.data()), facultyRecords.size() * sizeof(FacultyRecord)},
+            {pool.data(), pool.size()},
+            {state.data(), state.size()}};
+#ifndef _WIN32
+        int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = true;
+        for (const auto& part : parts) {
+            const char* next = part.first;
+            size_t left = part.second;
+            while (ok && left > 0) {
+                ssize_t written = ::write(fd, next, left);
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                ok = written > 0;
+                next += ok ? written : 0;
+                left -= ok ? written : 0;
+            }
+        }
+        // The data must be on disk before the rename makes it the snapshot the journal is cut against.
+        ok = ok && fsync(fd) == 0;
+        ok = ::close(fd) == 0 && ok;
+        if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+            remove(tempPath.c_str());
+            return false;
+        }
+        size_t slash = path.find_last_of('/');
+        string directory = slash == string::npos ? "." : path.substr(0, slash + 1);
+        int dirFd = ::open(directory.c_str(), O_RDONLY);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            ::close(dirFd);
+        }
+        return true;
+#else
+        ofstream outFile(tempPath, ios::binary | ios::trunc);
+        if (!outFile) {
+            return false;
+        }
+        for (const auto& part : parts) {
+            outFile.write(part.first, part.second);
+        }
+        outFile.close();
+        if (!outFile) {
+            remove(tempPath.c_str());
+            return false;
+        }
+        // rename() does not replace an existing file here, so this step alone is not atomic.
+        remove(path.c_str());
+        return rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+    }
+};
+
+enum class ImportKind { Students, Faculty, Enrollments, Attendance, Scores };
+
+struct ImportRow {
+    bool valid;
+    int id;
+    int age;
+    float number;
+    Cents money;
+    string text1;
+    string text2;
+    string text3;
+};
+
+class CsvImporter {
+private:
+    static const size_t CHUNK_LINES = 65536;
+
+    ImportKind kind;
+    size_t threadCount;
+
+    static void splitCsv(const string& line, vector<string>& fields) {
+        fields.clear();
+        string field;
+        bool quoted = false;
+        for (size_t i = 0; i < line.size(); ++i) {
+            char c = line[i];
+            if (quoted) {
+                if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                    field += '"';
+                    ++i;
+                } else if (c == '"') {
+                    quoted = false;
+                } else {
+                    field += c;
+                }
+            } else if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                fields.push_back(field);
+                field.clear();
+            } else if (c != '\r') {
+                field += c;
+            }
+        }
+        fields.push_back(field);
+    }
+
+    static bool parseInt(const string& text, int& value) {
+        char* end = nullptr;
+        long parsed = strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0' || parsed < INT32_MIN || parsed > INT32_MAX) {
+            return false;
+        }
+        value = int(parsed);
+        return true;
+    }
+
+    static bool parseFloat(const string& text, float& value) {
+        char* end = nullptr;
+        value = strtof(text.c_str(), &end);
+        return !text.empty() && *end == '\0' && isfinite(value);
+    }
+
+    bool parseRow(const string& line, vector<string>& fields, ImportRow& row) const {
+        splitCsv(line, fields);
+        switch (kind) {
+            case ImportKind::Students:
+                if (fields.size() < 5 || fields.size() > 6 || fields[0].empty() || fields[1].empty()
+                    || !parseInt(fields[2], row.id) || !parseInt(fields[3], row.age) || !parseMoney(fields[4], row.money)
+                    || row.age <= 0) {
+                    return false;
+                }
+                row.text1 = fields[0];
+                row.text2 = fields[1];
+                row.text3 = fields.size() == 6 && !fields[5].empty() ? fields[5] : "N/A";
+                return true;
+            case ImportKind::Faculty:
+                if (fields.size() != 2 || fields[0].empty() || fields[1].empty()) {
+                    return false;
+                }
+                row.text1 = fields[0];
+                row.text2 = fields[1];
+                return true;
+            case ImportKind::Enrollments:
+                if (fields.size() != 3 || !parseInt(fields[0], row.id) || fields[1].empty()) {
+                    return false;
+                }
+                row.text1 = fields[1];
+                row.text2 = fields[2];
+                return true;
+            case ImportKind::Attendance:
+                if (fields.size() != 3 || !parseInt(fields[0], row.id) || fields[1].empty()
+                    || !parseInt(fields[2], row.age) || row.age < 0 || row.age > 100) {
+                    return false;
+                }
+                row.text1 = fields[1];
+                return true;
+            case ImportKind::Scores:
+                if (fields.size() != 4 || !parseInt(fields[0], row.id) || fields[1].empty() || fields[2].empty()
+                    || !parseFloat(fields[3], row.number) || row.number < 0 || row.number > 100) {
+                    return false;
+                }
+                row.text1 = fields[1];
+                row.text2 = fields[2];
+                return true;
+        }
+        return false;
+    }
+
+    // Column names a header line must carry; a students file may leave out the trailing program column.
+    vector<string> headerColumns() const {
+        switch (kind) {
+            case ImportKind::Students:
+                return {"username", "password", "id", "age", "fee", "program"};
+            case ImportKind::Faculty:
+                return {"username", "password"};
+            case ImportKind::Enrollments:
+                return {"student_id", "course_code", "course_name"};
+            case ImportKind::Attendance:
+                return {"student_id", "course_code", "attendance"};
+            case ImportKind::Scores:
+                return {"student_id", "course_code", "exam_type", "score"};
+        }
+        return {};
+    }
+
+    bool isHeader(const string& line) const {
+        vector<string> fields;
+        splitCsv(line, fields);
+        vector<string> expected = headerColumns();
+        size_t required = kind == ImportKind::Students ? expected.size() - 1 : expected.size();
+        if (fields.size() < required || fields.size() > expected.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < fields.size(); ++i) {
+            string name;
+            for (char c : fields[i]) {
+                if (!isspace(static_cast<unsigned char>(c))) {
+                    name += char(tolower(static_cast<unsigned char>(c)));
+                }
+            }
+            if (name != expected[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void parseChunk(const vector<string>& lines, vector<ImportRow>& rows) const {
+        rows.resize(lines.size());
+        size_t workers = min(threadCount, max<size_t>(1, lines.size() / 1024));
+        vector<thread> pool;
+        size_t perWorker = (lines.size() + workers - 1) / workers;
+        for (size_t w = 0; w < workers; ++w) {
+            size_t begin = w * perWorker, end = min(lines.size(), begin + perWorker);
+            pool.emplace_back([this, &lines, &rows, begin, end]() {
+                vector<string> fields;
+                for (size_t i = begin; i < end; ++i) {
+                    rows[i].valid = parseRow(lines[i], fields, rows[i]);
+                }
+            });
+        }
+        for (auto& worker : pool) {
+            worker.join();
+        }
+    }
+
+public:
+    static bool parseKind(const string& name, ImportKind& kind) {
+        static const map<string, ImportKind> kinds = {
+            {"students", ImportKind::Students}, {"faculty", ImportKind::Faculty},
+            {"enrollments", ImportKind::Enrollments}, {"attendance", ImportKind::Attendance},
+            {"scores", ImportKind::Scores}};
+        auto it = kinds.find(name);
+        if (it == kinds.end()) {
+            return false;
+        }
+        kind = it->second;
+        return true;
+    }
+
+    explicit CsvImporter(ImportKind kind)
+        : kind(kind), threadCount(max(1u, thread::hardware_concurrency())) {}
+
+    template <typename Commit>
+    bool run(istream& in, Commit commit, size_t& rowsRead, size_t& rowsRejected) const {
+        rowsRead = rowsRejected = 0;
+        vector<string> lines;
+        vector<ImportRow> rows;
+        lines.reserve(CHUNK_LINES);
+        string line;
+        bool firstChunk = true;
+        while (true) {
+            lines.clear();
+            while (lines.size() < CHUNK_LINES && getline(in, line)) {
+                if (!line.empty() && line != "\r") {
+                    lines.push_back(line);
+                }
+            }
+            if (lines.empty()) {
+                break;
+            }
+            parseChunk(lines, rows);
+            for (size_t i = 0; i < rows.size(); ++i) {
+                if (firstChunk && i == 0 && !rows[i].valid && isHeader(lines[i])) {
+                    continue;
+                }
+                ++rowsRead;
+                if (!rows[i].valid || !commit(rows[i])) {
+                    ++rowsRejected;
+                }
+            }
+            firstChunk = false;
+        }
+        return true;
+    }
+};
+
+class TranscriptEngine {
+private:
+    static const size_t CHUNK_STUDENTS = 64;
+    static constexpr size_t MAX_IOVECS = 1024;
+
+    const vector<const Student*>& students;
+
+    size_t chunkCount() const {
+        return (students.size() + CHUNK_STUDENTS - 1) / CHUNK_STUDENTS;
+    }
+
+    template <typename Render>
+    void fanOut(size_t threads, Render render) const {
+        atomic<size_t> nextChunk(0);
+        size_t chunks = chunkCount();
+        auto worker = [&] {
+            StringSink buffer(CHUNK_STUDENTS * 1024);
+            for (size_t chunk; (chunk = nextChunk.fetch_add(1)) < chunks;) {
+                render(chunk, buffer);
+            }
+        };
+        vector<thread> pool;
+        for (size_t i = 1; i < threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : pool) {
+            t.join();
+        }
+    }
+
+    static bool writeFile(const string& path, const string& data) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        const char* next = data.data();
+        size_t left = data.size();
+        while (left > 0) {
+            ssize_t written = ::write(fd, next, left);
+            if (written <= 0) {
+                ::close(fd);
+                return false;
+            }
+            next += written;
+            left -= written;
+        }
+        return ::close(fd) == 0;
+#else
+        ofstream outFile(path, ios::binary);
+        outFile.write(data.data(), data.size());
+        return bool(outFile);
+#endif
+    }
+
+public:
+    explicit TranscriptEngine(const vector<const Student*>& list) : students(list) {}
+
+    vector<string> renderChunks(size_t threads) const {
+        vector<string> chunks(chunkCount());
+        fanOut(threads, [&](size_t chunk, StringSink& buffer) {
+            size_t end = min(students.size(), (chunk + 1) * CHUNK_STUDENTS);
+            for (size_t i = chunk * CHUNK_STUDENTS; i < end; ++i) {
+                students[i]->writeTranscript(buffer);
+            }
+            chunks[chunk] = buffer.take();
+        });
+        return chunks;
+    }
+
+    bool writePerStudent(const string& directory, size_t threads) const {
+        atomic<bool> ok(true);
+        fanOut(threads, [&](size_t chunk, StringSink& buffer) {
+            size_t end = min(students.size(), (chunk + 1) * CHUNK_STUDENTS);
+            for (size_t i = chunk * CHUNK_STUDENTS; i < end; ++i) {
+                buffer.clear();
+                students[i]->writeTranscript(buffer);
+                if (!writeFile(directory + to_string(students[i]->getId()) + ".txt", buffer.str())) {
+                    ok = false;
+                }
+            }
+        });
+        return ok;
+    }
+
+    static bool writeCombined(const string& path, const vector<string>& chunks) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        vector<struct iovec> pending;
+        for (const auto& chunk : chunks) {
+            if (!chunk.empty()) {
+                pending.push_back({const_cast<char*>(chunk.data()), chunk.size()});
+            }
+        }
+        size_t first = 0;
+        while (first < pending.size()) {
+            int count = int(min(MAX_IOVECS, pending.size() - first));
+            ssize_t written = ::writev(fd, &pending[first], count);
+            if (written <= 0) {
+                ::close(fd);
+                return false;
+            }
+            while (written > 0 && first < pending.size()) {
+                if (size_t(written) >= pending[first].iov_len) {
+                    written -= pending[first].iov_len;
+                    ++first;
+                } else {
+                    pending[first].iov_base = static_cast<char*>(pending[first].iov_base) + written;
+                    pending[first].iov_len -= written;
+                    written = 0;
+                }
+            }
+        }
+        return ::close(fd) == 0;
+#else
+        ofstream outFile(path, ios::binary);
+        for (const auto& chunk : chunks) {
+            outFile.write(chunk.data(), chunk.size());
+        }
+        return bool(outFile);
+#endif
+    }
+
+    static bool makeDirectory(const string& path) {
+#ifndef _WIN32
+        return ::mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#else
+        return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#endif
+    }
+};
+
+class StudentInformationSystem {
+private:
+    CourseRegistry catalog;
+    EnrollmentIndex enrollments;
+    Gradebook records;
+    FeeLedger ledger;
+    ObjectPool<Student> students;
+    ObjectPool<Faculty> faculty;
+    unordered_map<string, User*> userIndex;
+    unordered_map<int, Student*> studentIndex;
+    SearchIndex searchIndex;
+    NoticeBoard noticeBoard;
+    Library library;
+    Hostel hostel;
     EventManagementSystem eventManagementSystem;
 
-    const string studentFile = "students.txt"; 
-    const string facultyFile = "faculty.txt";   
+    const string studentFile = "students.txt"; 
+    const string facultyFile = "faculty.txt";   
+    const string snapshotFile = "sis.dat";
+    const string journalFile = "sis.log";
+    static constexpr size_t compactThreshold = 10000;
+
+    WriteAheadLog journal;
+    uint32_t generation = 0;
+    size_t compactRetryAt = 0;
+    bool persistent;
+
+    enum class Domain { People, Board, Books, Rooms, Count };
+
+    // perUser writes only touch their caller's own objects plus tables that lock themselves
+    // (gradebook, enrollment index, fee ledger, journal), so they share the domain under a user stripe.
+    struct CommandAccess {
+        Domain domain;
+        bool write;
+        bool perUser = false;
+    };
+
+    static bool commandAccess(const string& command, CommandAccess& access) {
+        static const unordered_map<string, CommandAccess> table = {
+            {"register-student", {Domain::People, true}}, {"register-faculty", {Domain::People, true}},
+            {"enroll", {Domain::People, true}}, {"teach", {Domain::People, true}},
+            {"attendance", {Domain::People, true, true}}, {"score", {Domain::People, true, true}},
+            {"grade", {Domain::People, true, true}}, {"session", {Domain::People, true, true}},
+            {"pay", {Domain::People, true, true}}, {"fees", {Domain::People, false}},
+            {"dues", {Domain::People, false}}, {"roster", {Domain::People, false}},
+            {"instructors", {Domain::People, false}}, {"faculty-students", {Domain::People, false}},
+            {"dashboard", {Domain::People, false}}, {"low-attendance", {Domain::People, false}},
+            {"course-average", {Domain::People, false}}, {"check-aggregates", {Domain::People, false}},
+            {"notice-add", {Domain::Board, true}}, {"notice-edit", {Domain::Board, true}},
+            {"notice-delete", {Domain::Board, true}}, {"event-add", {Domain::Board, true}},
+            {"event-edit", {Domain::Board, true}}, {"event-delete", {Domain::Board, true}},
+            {"notice-since", {Domain::Board, false}}, {"notice-latest", {Domain::Board, false}},
+            {"search", {Domain::Board, false}}, {"event-free", {Domain::Board, false}},
+            {"event-window", {Domain::Board, false}}, {"event-next", {Domain::Board, false}},
+            {"book-add", {Domain::Books, true}}, {"book-remove", {Domain::Books, true}},
+            {"book-checkout", {Domain::Books, true}}, {"book-return", {Domain::Books, true}},
+            {"book-loans", {Domain::Books, false}},
+            {"room-add", {Domain::Rooms, true}}, {"room-assign", {Domain::Rooms, true}},
+            {"room-auto", {Domain::Rooms, true}}, {"room-free", {Domain::Rooms, false}},
+        };
+        auto it = table.find(command);
+        if (it == table.end()) {
+            return false;
+        }
+        access = it->second;
+        return true;
+    }
+
+    static const size_t USER_STRIPES = 64;
+
+    mutable shared_timed_mutex domainLocks[size_t(Domain::Count)];
+    mutable mutex userStripes[USER_STRIPES];
+    mutable mutex compactLock;
+
+    mutex& userStripe(const string& username) const {
+        return userStripes[hash<string>()(username) % USER_STRIPES];
+    }
+
+    shared_timed_mutex& domainLock(Domain domain) const {
+        return domainLocks[size_t(domain)];
+    }
+
+    void compactShared() {
+        lock_guard<mutex> serialize(compactLock);
+        vector<unique_lock<shared_timed_mutex>> held;
+        for (auto& lock : domainLocks) {
+            held.emplace_back(lock);
+        }
+        compactIfNeeded();
+    }
+
+    bool loadSnapshot() {
+        SnapshotFile snapshot;
+        if (!snapshot.open(snapshotFile)) {
+            return false;
+        }
+        const SnapshotHeader& h = snapshot.header();
+        generation = h.generation;
+        string username, password, course;
+        for (uint32_t i = 0; i < h.studentCount; ++i) {
+            StudentRecord r = snapshot.student(i);
+            if (!snapshot.getString(r.username, username) || !snapshot.getString(r.password, password) || !snapshot.getString(r.course, course)) {
+                return false;
+            }
+            addStudent(username, password, r.id, r.age, course, r.feeCents);
+        }
+        for (uint32_t i = 0; i < h.facultyCount; ++i) {
+            FacultyRecord r = snapshot.faculty(i);
+            if (!snapshot.getString(r.username, username) || !snapshot.getString(r.password, password)) {
+                return false;
+            }
+            addFaculty(username, password);
+        }
+        istringstream state(snapshot.state());
+        replayRecords(state);
+        cout << "Snapshot loaded successfully.\n";
+        return true;
+    }
+
+    bool saveSnapshot(uint32_t snapshotGeneration) {
+        SnapshotWriter writer(snapshotGeneration);
+        for (const auto& student : students) {
+            writer.addStudent(student.getUsername(), student.getPassword(), student.getCourse(),
+                              student.getId(), student.getAge(), student.getFeeAmount());
+        }
+        for (const auto& member : faculty) {
+            writer.addFaculty(member.getUsername(), member.getPassword());
+        }
+        ostringstream state;
+        for (const auto& student : students) {
+            student.writeState(state);
+        }
+        for (const auto& member : faculty) {
+            member.writeState(state);
+        }
+        records.writeState(state);
+        noticeBoard.writeState(state);
+        library.writeState(state);
+        ledger.writeState(state);
+        hostel.writeState(state);
+        eventManagementSystem.writeState(state);
+        writer.setState(state.str());
+        if (!writer.write(snapshotFile)) {
+            cerr << "Failed to write snapshot file; the journal is kept.\n";
+            return false;
+        }
+        return true;
+    }
+
+    Student* findStudent(const string& username) const {
+        auto it = userIndex.find(username);
+        return it == userIndex.end() ? nullptr : it->second->asStudent();
+    }
+
+    Faculty* findFaculty(const string& username) const {
+        auto it = userIndex.find(username);
+        return it == userIndex.end() ? nullptr : it->second->asFaculty();
+    }
+
+    void applyRecord(const vector<string>& f) {
+        const string& type = f[0];
+        if (type == "student" && f.size() == 7) {
+            addStudent(f[1], f[2], stoi(f[3]), stoi(f[4]), f[5], money(f[6]));
+        } else if (type == "faculty" && f.size() == 3) {
+            addFaculty(f[1], f[2]);
+        } else if (type == "enroll" && f.size() == 4) {
+            if (Student* student = findStudent(f[1])) student->addCourse(f[2], f[3]);
+        } else if (type == "pay" && f.size() == 3) {
+            if (Student* student = findStudent(f[1])) student->makePayment(money(f[2]));
+        } else if (type == "fee-pay" && f.size() == 5) {
+            ledger.restorePayment(stoi(f[1]), stoll(f[2]), stoll(f[3]), stoul(f[4]));
+        } else if (type == "fee-batch" && f.size() >= 3 && f.size() % 2 == 1) {
+            for (size_t i = 3; i < f.size(); i += 2) {
+                ledger.restorePayment(stoi(f[i]), stoll(f[i + 1]), stoll(f[2]), stoul(f[1]));
+            }
+        } else if (type == "teach" && f.size() == 4) {
+            if (Faculty* faculty = findFaculty(f[1])) faculty->assignCourse(f[2], f[3]);
+        } else if (type == "attendance" && f.size() == 4) {
+            records.recordAttendance(stoi(f[1]), f[2], stoi(f[3]));
+        } else if (type == "class-seats" && f.size() >= 2) {
+            vector<int> seats;
+            for (size_t i = 2; i < f.size(); ++i) {
+                seats.push_back(stoi(f[i]));
+            }
+            records.restoreSeats(f[1], seats);
+        } else if (type == "session" && f.size() == 5) {
+            records.restoreSession(f[1], f[2], stoul(f[3]), f[4]);
+        } else if (type == "score" && f.size() == 5) {
+            records.recordExamScore(stoi(f[1]), f[2], f[3], stof(f[4]));
+        } else if (type == "grade" && f.size() == 4) {
+            records.assignFinalGrade(stoi(f[1]), f[2], stof(f[3]));
+        } else if (type == "notice-seq" && f.size() == 2) {
+            noticeBoard.restoreNextId(stoi(f[1]));
+        } else if (type == "notice" && f.size() == 5) {
+            noticeBoard.restoreNotice(stoi(f[1]), stoll(f[2]), f[3], f[4]);
+        } else if (type == "notice-edit" && f.size() == 3) {
+            noticeBoard.editNotice(stoi(f[1]), f[2]);
+        } else if (type == "notice-delete" && f.size() == 2) {
+            noticeBoard.deleteNotice(stoi(f[1]));
+        } else if (type == "book" && (f.size() == 2 || f.size() == 3)) {
+            library.addBook(f[1], f.size() == 3 ? f[2] : "");
+        } else if (type == "book-remove" && f.size() == 2) {
+            library.removeBook(f[1]);
+        } else if (type == "book-checkout" && f.size() == 3) {
+            library.checkOutBook(f[1], f[2]);
+        } else if (type == "book-return" && f.size() == 3) {
+            library.returnBook(f[1], f[2]);
+        } else if (type == "room" && (f.size() == 2 || f.size() == 3)) {
+            hostel.addRoom(f[1], f.size() == 3 ? stoul(f[2]) : 1);
+        } else if (type == "room-assign" && f.size() == 3) {
+            hostel.assignRoom(f[1], f[2]);
+        } else if (type == "event-seq" && f.size() == 2) {
+            eventManagementSystem.restoreNextId(stoi(f[1]));
+        } else if (type == "event" && (f.size() == 7 || f.size() == 8)) {
+            eventManagementSystem.restoreEvent(stoi(f[1]), f[2], f[3], f[4], f[5], f[6], f.size() == 8 ? stoi(f[7]) : 60);
+        } else if (type == "event-edit" && (f.size() == 7 || f.size() == 8)) {
+            eventManagementSystem.editEvent(stoi(f[1]), f[2], f[3], f[4], f[5], f[6], f.size() == 8 ? stoi(f[7]) : 60);
+        } else if (type == "event-delete" && f.size() == 2) {
+            eventManagementSystem.deleteEvent(stoi(f[1]));
+        }
+    }
+
+    void replayRecords(istream& in) {
+        OutputSilencer silencer;
+        string line;
+        while (getline(in, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            try {
+                applyRecord(WriteAheadLog::split(line));
+            } catch (const exception&) {
+                // A torn or corrupt record only loses itself.
+            }
+        }
+    }
+
+    enum class JournalState { Missing, Stale, Replayed, Mismatched };
+
+    // Only an absent log or one already folded into the snapshot may be truncated; anything else still holds data.
+    JournalState replayJournal() {
+        ifstream inFile(journalFile);
+        string header;
+        if (!inFile || !getline(inFile, header)) {
+            return inFile.is_open() && inFile.peek() != EOF ? JournalState::Mismatched : JournalState::Missing;
+        }
+        vector<string> fields = WriteAheadLog::split(header);
+        char* end = nullptr;
+        unsigned long logGeneration = fields.size() == 2 ? strtoul(fields[1].c_str(), &end, 10) : 0;
+        if (fields.size() != 2 || fields[0] != "#sis-log" || fields[1].empty() || *end != '\0' || logGeneration > generation) {
+            return JournalState::Mismatched;
+        }
+        if (logGeneration < generation) {
+            return JournalState::Stale;
+        }
+        replayRecords(inFile);
+        cout << "Journal replayed successfully.\n";
+        return JournalState::Replayed;
+    }
+
+    void setAsideJournal() {
+        string aside = journalFile + "." + to_string(time(0)) + ".unreplayed";
+        if (rename(journalFile.c_str(), aside.c_str()) != 0) {
+            throw runtime_error("journal " + journalFile + " does not match snapshot generation " + to_string(generation)
+                                + " and could not be moved aside");
+        }
+        cerr << "Journal " << journalFile << " does not match snapshot generation " << generation << "; moved to " << aside
+             << " without replaying it.\n";
+    }
+
+    void attachJournal(bool truncate) {
+        if (!journal.open(journalFile, generation, truncate)) {
+            cout << "Failed to open journal file.\n";
+            return;
+        }
+        for (auto& student : students) {
+            student.setJournal(&journal);
+        }
+        for (auto& member : faculty) {
+            member.setJournal(&journal);
+        }
+        records.setJournal(&journal);
+        noticeBoard.setJournal(&journal);
+        library.setJournal(&journal);
+        hostel.setJournal(&journal);
+        eventManagementSystem.setJournal(&journal);
+        ledger.setJournal(&journal);
+    }
+
+    // The journal is only cut once a snapshot of the next generation is safely on disk.
+    bool compact() {
+        if (!saveSnapshot(generation + 1)) {
+            return false;
+        }
+        ++generation;
+        compactRetryAt = 0;
+        if (!journal.open(journalFile, generation, true)) {
+            cerr << "Failed to open journal file.\n";
+        }
+        return true;
+    }
+
+    void compactIfNeeded() {
+        if (!persistent) {
+            return;
+        }
+        size_t liveRecords = students.size() + faculty.size() + records.recordCount() + ledger.recordCount()
+                           + noticeBoard.recordCount() + library.recordCount() + hostel.recordCount()
+                           + eventManagementSystem.recordCount();
+        if (journal.size() >= max({compactThreshold, liveRecords, compactRetryAt}) && !compact()) {
+            // Keep appending to the current log and try again after another threshold's worth of records.
+            compactRetryAt = journal.size() + compactThreshold;
+        }
+    }
+
+    void loadStudents() {
+        ifstream inFile(studentFile);
+        if (!inFile) {
+            cout << "No student data file found. Starting fresh.\n";
+            return;
+        }
+        string username, password, course;
+        int id, age;
+        string feeAmount;
+        Cents fee;
+        while (inFile >> username >> password >> id >> age >> course >> feeAmount) {
+            if (parseMoney(feeAmount, fee)) {
+                addStudent(username, password, id, age, course, fee);
+            }
+        }
+        inFile.close();
+        cout << "Student data loaded successfully.\n";
+    }
+
+    void loadFaculty() {
+        ifstream inFile(facultyFile);
+        if (!inFile) {
+            cout << "No faculty data file found. Starting fresh.\n";
+            return;
+        }
+        string username, password;
+        while (inFile >> username >> password) {
+            addFaculty(username, password);
+        }
+        inFile.close();
+        cout << "Faculty data loaded successfully.\n";
+    }
+
+    void saveStudents() {
+        ofstream outFile(studentFile);
+        for (const auto& student : students) {
+            outFile << student.getUsername() << " "
+                    << student.getPassword() << " "
+                    << student.getId() << " "
+                    << student.getAge() << " "
+                    << student.getCourse() << " "
+                    << formatMoney(student.getFeeAmount()) << "\n";
+        }
+        outFile.close();
+    }
+
+    void saveFaculty() {
+        ofstream outFile(facultyFile);
+        for (const auto& member : faculty) {
+            outFile << member.getUsername() << " "
+                    << member.getPassword() << " \n";
+        }
+        outFile.close();
+    }
+
+    bool addStudent(const string& username, const string& password, int id, int age, const string& course, Cents fee) {
+        if (userIndex.count(username) || studentIndex.count(id)) {
+            return false;
+        }
+        Student& student = students.create(username, password, id, age, course, &catalog, &enrollments, &records, &ledger);
+        ledger.openAccount(id, fee);
+        userIndex.emplace(username, &student);
+        studentIndex.emplace(id, &student);
+        if (journal.isOpen()) {
+            student.setJournal(&journal);
+            journal.append({"student", username, password, to_string(id), to_string(age), course, formatMoney(fee)});
+        }
+        return true;
+    }
+
+    bool addFaculty(const string& username, const string& password) {
+        if (userIndex.count(username)) {
+            return false;
+        }
+        Faculty& member = faculty.create(username, password, &catalog, &enrollments, &records);
+        userIndex.emplace(username, &member);
+        if (journal.isOpen()) {
+            member.setJournal(&journal);
+            journal.append({"faculty", username, password});
+        }
+        return true;
+    }
+
+public:
+    explicit StudentInformationSystem(bool persistent = true) : records(catalog), persistent(persistent) {
+        noticeBoard.setSearchIndex(&searchIndex);
+        eventManagementSystem.setSearchIndex(&searchIndex);
+        if (!persistent) {
+            journal.suspend();
+            return;
+        }
+        if (!loadSnapshot()) {
+            loadStudents(); 
+            loadFaculty();  
+        }
+        JournalState state = replayJournal();
+        if (state == JournalState::Mismatched) {
+            setAsideJournal();
+        }
+        attachJournal(state != JournalState::Replayed);
+    }
+
+    ~StudentInformationSystem() {
+        if (!persistent) {
+            return;
+        }
+        compact();
+        saveStudents(); 
+        saveFaculty();  
+    }
+
+    void registerStudent() {
+        string username, password, name;
+        int id, age;
+        string feeAmount;
+        Cents fee;
+        cout << "Enter Student Name: ";
+        cin.ignore();
+        getline(cin, name);
+        cout << "Enter Student ID: ";
+        cin >> id;
+        cout << "Enter Age: ";
+        cin >> age;
+        cout << "Enter Fee Amount: ";
+        cin >> feeAmount;
+        cout << "Enter Username: ";
+        cin >> username;
+        cout << "Enter Password: ";
+        cin >> password;
+        if (!parseMoney(feeAmount, fee)) {
+            cout << "Invalid fee amount!\n";
+        } else if (studentIndex.count(id)) {
+            cout << "Student ID already exists!\n";
+        } else if (addStudent(username, password, id, age, "N/A", fee)) {
+            cout << "Student registered successfully!\n";
+        } else {
+            cout << "Username already exists!\n";
+        }
+    }
+
+    void registerFaculty() {
+        string username, password, name;
+        cout << "Enter Faculty Name: ";
+        cin.ignore();
+        getline(cin, name);
+        cout << "Enter Username: ";
+        cin >> username;
+        cout << "Enter Password: ";
+        cin >> password;
+        if (addFaculty(username, password)) {
+            cout << "Faculty registered successfully!\n";
+        } else {
+            cout << "Username already exists!\n";
+        }
+    }
+
+    User* login(const string& username, const string& password) {
+        auto it = userIndex.find(username);
+        if (it != userIndex.end() && it->second->checkLogin(username, password)) {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    void manageNotices() {
+        int choice;
+        do {
+            cout << "\nNotice Management Menu\n";
+            cout << "1. Add Notice\n";
+            cout << "2. Edit Notice\n";
+            cout << "3. Delete Notice\n";
+            cout << "4. View Notices\n";
+            cout << "5. View Notices in Category Since Date\n";
+            cout << "6. View Latest Notices\n";
+            cout << "7. Back to Main Menu\n";
+            cout << "Enter your choice: ";
+            cin >> choice;
+
+            switch (choice) {
+                case 1: {
+                    string message, category;
+                    cout << "Enter Notice Message: ";
+                    cin.ignore();
+                    getline(cin, message);
+                    cout << "Enter Notice Category: ";
+                    cin >> category;
+                    noticeBoard.addNotice(message, category);
+                    break;
+                }
+                case 2: {
+                    int id;
+                    string newMessage;
+                    cout << "Enter Notice ID: ";
+                    cin >> id;
+                    cout << "Enter New Message: ";
+                    cin.ignore();
+                    getline(cin, newMessage);
+                    noticeBoard.editNotice(id, newMessage);
+                    break;
+                }
+                case 3: {
+                    int id;
+                    cout << "Enter Notice ID: ";
+                    cin >> id;
+                    noticeBoard.deleteNotice(id);
+                    break;
+                }
+                case 4:
+                    noticeBoard.viewNotices();
+                    break;
+                case 5: {
+                    string category, date;
+                    time_t since;
+                    cout << "Enter Notice Category: ";
+                    cin >> category;
+                    cout << "Enter Date (YYYY-MM-DD): ";
+                    cin >> date;
+                    if (!parseDate(date, since)) {
+                        cout << "Invalid date!\n";
+                        break;
+                    }
+                    noticeBoard.viewNotices(noticeBoard.noticesSince(category, since));
+                    break;
+                }
+                case 6: {
+                    size_t count;
+                    cout << "Enter Number of Notices: ";
+                    cin >> count;
+                    noticeBoard.viewNotices(noticeBoard.latestNotices(count));
+                    break;
+                }
+                case 7:
+                    cout << "Returning to main menu...\n";
+                    break;
+                default:
+                    cout << "Invalid choice! Please try again.\n";
+            }
+        } while (choice != 7);
+    }
+
+    void manageLibrary() {
+        int choice;
+        do {
+            cout << "\nLibrary Management Menu\n";
+            cout << "1. Add Book\n";
+            cout << "2. Remove Book\n";
+            cout << "3. Check Out Book\n";
+            cout << "4. Return Book\n";
+            cout << "5. View Books\n";
+            cout << "6. View Books Checked Out by Borrower\n";
+            cout << "7. Back to Main Menu\n";
+            cout << "Enter your choice: ";
+            cin >> choice;
+
+            switch (choice) {
+                case 1: {
+                    string book, isbn;
+                    cout << "Enter Book Name: ";
+                    cin >> book;
+                    cout << "Enter ISBN (- if none): ";
+                    cin >> isbn;
+                    library.addBook(book, isbn == "-" ? "" : isbn);
+                    break;
+                }
+                case 2: {
+                    string book;
+                    cout << "Enter Book Name: ";
+                    cin >> book;
+                    library.removeBook(book);
+                    break;
+                }
+                case 3: {
+                    string book, borrower;
+                    cout << "Enter Book Name: ";
+                    cin >> book;
+                    cout << "Enter Borrower Name: ";
+                    cin >> borrower;
+                    library.checkOutBook(book, borrower);
+                    break;
+                }
+                case 4: {
+                    string book, borrower;
+                    cout << "Enter Book Name: ";
+                    cin >> book;
+                    cout << "Enter Borrower Name: ";
+                    cin >> borrower;
+                    library.returnBook(book, borrower);
+                    break;
+                }
+                case 5:
+                    library.viewBooks();
+                    break;
+                case 6: {
+                    string borrower;
+                    cout << "Enter Borrower Name: ";
+                    cin >> borrower;
+                    library.viewLoans(borrower);
+                    break;
+                }
+                case 7:
+                    cout << "Returning to main menu ...\n";
+                    break;
+                default:
+                    cout << "Invalid choice! Please try again.\n";
+            }
+        } while (choice != 7);
+    }
+
+    size_t autoAssignRooms() {
+        vector<string> incoming;
+        incoming.reserve(students.size());
+        for (const auto& student : students) {
+            incoming.push_back(student.getUsername());
+        }
+        return hostel.autoAssign(incoming);
+    }
+
+    void manageHostel() {
+        int choice;
+        do {
+            cout << "\nHostel Management Menu\n";
+            cout << "1. Add Room\n";
+            cout << "2. Assign Room\n";
+            cout << "3. View Rooms\n";
+            cout << "4. View Room Assignments\n";
+            cout << "5. Auto-Assign Unhoused Students\n";
+            cout << "6. Find First Free Bed\n";
+            cout << "7. Back to Main Menu\n";
+            cout << "Enter your choice: ";
+            cin >> choice;
+
+            switch (choice) {
+                case 1: {
+                    string room;
+                    uint32_t capacity;
+                    cout << "Enter Room Number: ";
+                    cin >> room;
+                    cout << "Enter Number of Beds: ";
+                    cin >> capacity;
+                    hostel.addRoom(room, capacity);
+                    break;
+                }
+                case 2: {
+                    string room, student;
+                    cout << "Enter Room Number: ";
+                    cin >> room;
+                    cout << "Enter Student Name: ";
+                    cin >> student;
+                    hostel.assignRoom(room, student);
+                    break;
+                }
+                case 3:
+                    hostel.viewRooms();
+                    break;
+                case 4:
+                    hostel.viewRoomAssignments();
+                    break;
+                case 5:
+                    autoAssignRooms();
+                    break;
+                case 6: {
+                    string room;
+                    uint32_t bed;
+                    if (hostel.firstFreeBed(room, bed)) {
+                        cout << "First free bed: Room " << room << ", Bed " << bed << "\n";
+                    } else {
+                        cout << "No free beds available.\n";
+                    }
+                    break;
+                }
+                case 7:
+                    cout << "Returning to main menu...\n";
+                    break;
+                default:
+                    cout << "Invalid choice! Please try again.\n";
+            }
+        } while (choice != 7);
+    }
+
+    void manageEvents() {
+        int choice;
+        do {
+            cout << "\nEvent Management Menu\n";
+            cout << "1. Add Event\n";
+            cout << "2. Edit Event\n";
+            cout << "3. Delete Event\n";
+            cout << "4. View Events\n";
+            cout << "5. Check Venue Availability\n";
+            cout << "6. View Events in Time Window\n";
+            cout << "7. View Upcoming Events\n";
+            cout << "8. Back to Main Menu\n";
+            cout << "Enter your choice: ";
+            cin >> choice;
+
+            switch (choice) {
+                case 1: {
+                    string name, description, date, time, location;
+                    cout << "Enter Event Name: ";
+                    cin.ignore();
+                    getline(cin, name);
+                    cout << "Enter Event Description: ";
+                    getline(cin, description);
+                    int duration;
+                    cout << "Enter Event Date (YYYY-MM-DD): ";
+                    cin >> date;
+                    cout << "Enter Event Time (HH:MM): ";
+                    cin >> time;
+                    cout << "Enter Duration (minutes): ";
+                    cin >> duration;
+                    cout << "Enter Event Location: ";
+                    cin >> location;
+                    eventManagementSystem.addEvent(name, description, date, time, location, duration);
+                    break;
+                }
+                case 2: {
+                    int id;
+                    string newName, newDescription, newDate, newTime, newLocation;
+                    cout << "Enter Event ID: ";
+                    cin >> id;
+                    cout << "Enter New Event Name: ";
+                    cin.ignore();
+                    getline(cin, newName);
+                    cout << "Enter New Event Description: ";
+                    getline(cin, newDescription);
+                    int newDuration;
+                    cout << "Enter New Event Date (YYYY-MM-DD): ";
+                    cin >> newDate;
+                    cout << "Enter New Event Time (HH:MM): ";
+                    cin >> newTime;
+                    cout << "Enter New Duration (minutes): ";
+                    cin >> newDuration;
+                    cout << "Enter New Event Location: ";
+                    cin >> newLocation;
+                    eventManagementSystem.editEvent(id, newName, newDescription, newDate, newTime, newLocation, newDuration);
+                    break;
+                }
+                case 3: {
+                    int id;
+                    cout << "Enter Event ID: ";
+                    cin >> id;
+                    eventManagementSystem.deleteEvent(id);
+                    break;
+                }
+                case 4:
+                    eventManagementSystem.viewEvents();
+                    break;
+                case 5: {
+                    string location, date, time;
+                    int duration;
+                    time_t start;
+                    cout << "Enter Event Location: ";
+                    cin >> location;
+                    cout << "Enter Date (YYYY-MM-DD): ";
+                    cin >> date;
+                    cout << "Enter Time (HH:MM): ";
+                    cin >> time;
+                    cout << "Enter Duration (minutes): ";
+                    cin >> duration;
+                    if (!parseLocalTime(date, time, start)) {
+                        cout << "Invalid date or time!\n";
+                        break;
+                    }
+                    int conflict = eventManagementSystem.venueConflict(location, start, duration);
+                    if (conflict) {
+                        cout << "Venue " << location << " is booked by event " << conflict << " at that time.\n";
+                    } else {
+                        cout << "Venue " << location << " is free at that time.\n";
+                    }
+                    break;
+                }
+                case 6: {
+                    string fromDate, fromTime, toDate, toTime;
+                    time_t from, to;
+                    cout << "Enter Start Date (YYYY-MM-DD): ";
+                    cin >> fromDate;
+                    cout << "Enter Start Time (HH:MM): ";
+                    cin >> fromTime;
+                    cout << "Enter End Date (YYYY-MM-DD): ";
+                    cin >> toDate;
+                    cout << "Enter End Time (HH:MM): ";
+                    cin >> toTime;
+                    if (!parseLocalTime(fromDate, fromTime, from) || !parseLocalTime(toDate, toTime, to)) {
+                        cout << "Invalid date or time!\n";
+                        break;
+                    }
+                    eventManagementSystem.viewEvents(eventManagementSystem.eventsInWindow(from, to));
+                    break;
+                }
+                case 7: {
+                    size_t count;
+                    cout << "Enter Number of Events: ";
+                    cin >> count;
+                    eventManagementSystem.viewEvents(eventManagementSystem.upcomingEvents(time(0), count));
+                    break;
+                }
+                case 8:
+                    cout << "Returning to main menu...\n";
+                    break;
+                default:
+                    cout << "Invalid choice! Please try again.\n";
+            }
+        } while (choice != 8);
+    }
+
+    vector<const Student*> studentsById() const {
+        vector<const Student*> list;
+        list.reserve(students.size());
+        for (const auto& student : students) {
+            list.push_back(&student);
+        }
+        sort(list.begin(), list.end(), [](const Student* a, const Student* b) { return a->getId() < b->getId(); });
+        return list;
+    }
 
-    void loadStudents() {
-        ifstream inFile(studentFile);
-        if (!inFile) {
-            cout << "No student data file found. Starting fresh.\n";
-            return;
+    bool generateTranscripts(const string& path, size_t threads) const {
+        vector<const Student*> list = studentsById();
+        TranscriptEngine engine(list);
+        bool perStudent = !path.empty() && (path.back() == '/' || path.back() == '\\');
+        auto start = chrono::steady_clock::now();
+        bool ok;
+        if (perStudent) {
+            ok = TranscriptEngine::makeDirectory(path.substr(0, path.size() - 1)) && engine.writePerStudent(path, threads);
+        } else {
+            ok = TranscriptEngine::writeCombined(path, engine.renderChunks(threads));
         }
-        string username, password, course;
-        int id, age;
-        float feeAmount;
-        while (inFile >> username >> password >> id >> age >> course >> feeAmount) {
-            User* student = new Student(username, password, id, age, course, feeAmount);
-            users.push_back(student);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (!ok) {
+            cout << "Failed to write transcripts to " << path << "\n";
+            return false;
         }
-        inFile.close();
-        cout << "Student data loaded successfully.\n";
+        cout << "Transcripts written for " << list.size() << " students to " << path << " in " << seconds << " s";
+        if (seconds > 0) {
+            cout << " (" << size_t(list.size() / seconds) << " students/s on " << threads << " threads)";
+        }
+        cout << "\n";
+        return true;
     }
 
-    void loadFaculty() {
-        ifstream inFile(facultyFile);
-        if (!inFile) {
-            cout << "No faculty data file found. Starting fresh.\n";
+    void reportTranscriptScaling() const {
+        vector<const Student*> list = studentsById();
+        if (list.empty()) {
+            cout << "No students registered.\n";
             return;
         }
-        string username, password;
-        while (inFile >> username >> password) {
-            User* faculty = new Faculty(username, password);
-            users.push_back(faculty);
+        TranscriptEngine engine(list);
+        size_t cores = max(1u, thread::hardware_concurrency());
+        vector<size_t> counts;
+        for (size_t threads = 1; threads < cores; threads *= 2) {
+            counts.push_back(threads);
         }
-        inFile.close();
-        cout << "Faculty data loaded successfully.\n";
-    }
-
-    void saveStudents() {
-        ofstream outFile(studentFile);
-        for (const auto& user : users) {
-            if (user->getRole() == "student") {
-                Student* student = dynamic_cast<Student*>(user);
-                if (student) {
-                    outFile << student->getUsername() << " "
-                            << student->getPassword() << " "
-                            << student->getId() << " "
-                            << student->getAge() << " "
-                            << student->getCourse() << " "
-                            << student->getFeeAmount() << "\n";
-                }
+        counts.push_back(cores);
+        cout << "Transcript rendering for " << list.size() << " students (" << cores << " hardware threads):\n";
+        double baseline = 0;
+        for (size_t threads : counts) {
+            auto start = chrono::steady_clock::now();
+            size_t bytes = 0;
+            for (const auto& chunk : engine.renderChunks(threads)) {
+                bytes += chunk.size();
+            }
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            double rate = list.size() / max(seconds, 1e-9);
+            if (baseline == 0) {
+                baseline = rate;
             }
+            cout << "  " << threads << " threads: " << size_t(rate) << " students/s (" << fixed << setprecision(2)
+                 << rate / baseline << "x, " << bytes / 1024 << " KB)\n" << defaultfloat;
         }
-        outFile.close();
     }
 
-    void saveFaculty() {
-        ofstream outFile(facultyFile);
-        for (const auto& user : users) {
-            if (user->getRole() == "faculty") {
-                Faculty* faculty = dynamic_cast<Faculty*>(user);
-                if (faculty) {
-                    outFile << faculty->getUsername() << " "
-                            << faculty->getPassword() << " \n";
-                }
-            }
+    void viewDashboard() const {
+        StreamSink out(cout);
+        viewDashboard(out);
+    }
+
+    // Every figure here is a running total, so the dashboard costs the same at any population.
+    void viewDashboard(OutputSink& out) const {
+        size_t dueCount;
+        Cents outstanding;
+        ledger.outstandingSummary(dueCount, outstanding);
+        out << "Dashboard:\n";
+        out << "Students: " << students.size() << "\n";
+        out << "Students Below " << Gradebook::lowAttendanceMark() << "% Attendance: " << records.lowAttendanceCount() << "\n";
+        out << "Outstanding Dues: $" << formatMoney(outstanding) << " across " << dueCount << " students\n";
+        vector<Gradebook::GradeAverage> averages = records.finalGradeAverages();
+        if (averages.empty()) {
+            out << "No final grades assigned.\n";
+            return;
+        }
+        out << "Average Final Grade by Course:\n";
+        for (const auto& average : averages) {
+            out << "  Course: " << average.courseCode << " | Mean: " << average.mean << " | Grades: " << average.count << "\n";
         }
-        outFile.close();
     }
 
-public:
-    StudentInformationSystem() {
-        loadStudents(); 
-        loadFaculty();  
+    bool checkAggregates() const {
+        StreamSink out(cout);
+        return checkAggregates(out);
     }
 
-    ~StudentInformationSystem() {
-        saveStudents(); 
-        saveFaculty();  
+    bool checkAggregates(OutputSink& out) const {
+        vector<string> problems;
+        auto start = chrono::steady_clock::now();
+        records.verifyAggregates(problems);
+        ledger.verifyTotals(problems);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (problems.empty()) {
+            out << "All dashboard aggregates match a full recount (" << seconds << " s).\n";
+            return true;
+        }
+        out << "Aggregate mismatches found (" << problems.size() << "):\n";
+        for (const auto& problem : problems) {
+            out << "  " << problem << "\n";
+        }
+        return false;
     }
 
-    void registerStudent() {
-        string username, password, name;
-        int id, age;
-        float feeAmount;
-        cout << "Enter Student Name: ";
-        cin.ignore();
-        getline(cin, name);
-        cout << "Enter Student ID: ";
-        cin >> id;
-        cout << "Enter Age: ";
-        cin >> age;
-        cout << "Enter Fee Amount: ";
-        cin >> feeAmount;
-        cout << "Enter Username: ";
-        cin >> username;
-        cout << "Enter Password: ";
-        cin >> password;
-        User* student = new Student(username, password, id, age, "N/A", feeAmount);
-        users.push_back(student);
-        cout << "Student registered successfully!\n";
+    void reportMemoryFootprint() const {
+        StreamSink out(cout);
+        if (students.size() == 0) {
+            out << "No students registered.\n";
+            return;
+        }
+        size_t heapBytes = 0;
+        for (const auto& student : students) {
+            heapBytes += student.heapBytes();
+        }
+        size_t indexBytes = students.size() * 2 * (sizeof(pair<const string, User*>) + 2 * sizeof(void*));
+        size_t totalBytes = students.reservedBytes() + heapBytes + indexBytes + records.heapBytes() + ledger.heapBytes() + catalog.heapBytes() + enrollments.heapBytes();
+        out << "Memory Footprint:\n";
+        out << "Students: " << students.size() << "\n";
+        out << "Student Object Size: " << sizeof(Student) << " bytes\n";
+        out << "Pool Reserved: " << students.reservedBytes() << " bytes\n";
+        out << "Heap (strings, courses, maps): " << heapBytes << " bytes\n";
+        out << "User Indexes: " << indexBytes << " bytes\n";
+        out << "Academic Records (shared): " << records.heapBytes() << " bytes\n";
+        out << "Fee Ledger (shared): " << ledger.heapBytes() << " bytes\n";
+        out << "Course Catalog (" << catalog.size() << " courses): " << catalog.heapBytes() << " bytes\n";
+        out << "Enrollment Index: " << enrollments.heapBytes() << " bytes\n";
+        out << "Bytes per Student: " << totalBytes / students.size() << "\n";
     }
 
-    void registerFaculty() {
-        string username, password, name;
-        cout << "Enter Faculty Name: ";
-        cin.ignore();
-        getline(cin, name);
-        cout << "Enter Username: ";
-        cin >> username;
-        cout << "Enter Password: ";
-        cin >> password;
-        User* faculty = new Faculty(username, password);
-        users.push_back(faculty);
-        cout << "Faculty registered successfully!\n";
+    void reportGradeStatistics() const {
+        StreamSink out(cout);
+        const float passMark = 40.0f;
+        map<pair<string, string>, vector<float>> groups;
+        records.collectScores(groups);
+        if (groups.empty()) {
+            out << "No exam scores recorded.\n";
+            return;
+        }
+        out << "Grade Statistics (pass mark " << passMark << "):\n";
+        auto it = groups.begin();
+        while (it != groups.end()) {
+            const string& courseCode = it->first.first;
+            vector<float> courseScores;
+            for (; it != groups.end() && it->first.first == courseCode; ++it) {
+                out << "Course: " << courseCode << " | Exam: " << it->first.second << "\n";
+                GradeStatistics::display(GradeStatistics::summarize(it->second.data(), it->second.size(), passMark), out);
+                courseScores.insert(courseScores.end(), it->second.begin(), it->second.end());
+            }
+            out << "Course: " << courseCode << " | All Exams\n";
+            GradeStatistics::display(GradeStatistics::summarize(courseScores.data(), courseScores.size(), passMark), out);
+        }
+    }
+
+    bool postPaymentFile(const string& path) {
+        ifstream inFile(path);
+        if (!inFile) {
+            cout << "Cannot open payment file " << path << "\n";
+            return false;
+        }
+        vector<FeeLedger::Payment> payments;
+        size_t lines = 0, malformed = 0;
+        auto start = chrono::steady_clock::now();
+        string line;
+        while (getline(inFile, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                continue;
+            }
+            FeeLedger::Payment payment;
+            if (FeeLedger::parsePayment(line, payment)) {
+                payments.push_back(payment);
+            } else if (lines > 0) {
+                ++malformed;
+            }
+            ++lines;
+        }
+        vector<FeeLedger::PostStatus> statuses;
+        FeeLedger::BatchResult result = ledger.postBatch(payments, statuses);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        size_t unknown = count(statuses.begin(), statuses.end(), FeeLedger::PostStatus::UnknownStudent);
+        size_t rejected = statuses.size() - result.posted - unknown;
+        cout << "Batch " << result.batch << ": posted " << result.posted << " of " << payments.size() + malformed
+             << " payments totaling $" << formatMoney(result.total) << " (" << unknown << " unknown students, "
+             << rejected << " over amount due, " << malformed << " malformed) in " << seconds << " s\n";
+        return true;
     }
 
-    User* login(string username, string password) {
-        for (auto& user : users) {
-            if (user->checkLogin(username, password)) {
-                return user;
+    void viewStudentsWithDues() const {
+        vector<pair<int, Cents>> dues = ledger.studentsWithDues();
+        size_t count;
+        Cents total;
+        ledger.outstandingSummary(count, total);
+        StreamSink out(cout);
+        if (dues.empty()) {
+            out << "No outstanding dues.\n";
+            return;
+        }
+        out << "Students With Dues (" << count << " students, $" << formatMoney(total) << " outstanding):\n";
+        for (const auto& entry : dues) {
+            auto it = studentIndex.find(entry.first);
+            out << "Student ID: " << entry.first;
+            if (it != studentIndex.end()) {
+                out << " (" << it->second->getUsername() << ")";
             }
+            out << " | Due: $" << formatMoney(entry.second) << "\n";
         }
-        return nullptr;
     }
 
-    void manageNotices() {
+    void manageFees() {
         int choice;
         do {
-            cout << "\nNotice Management Menu\n";
-            cout << "1. Add Notice\n";
-            cout << "2. Edit Notice\n";
-            cout << "3. Delete Notice\n";
-            cout << "4. View Notices\n";
-            cout << "5. Back to Main Menu\n";
+            cout << "\nFee Management Menu\n";
+            cout << "1. Post Payment File\n";
+            cout << "2. View Students With Dues\n";
+            cout << "3. Back to Main Menu\n";
             cout << "Enter your choice: ";
             cin >> choice;
 
             switch (choice) {
                 case 1: {
-                    string message, category;
-                    cout << "Enter Notice Message: ";
-                    cin.ignore();
-                    getline(cin, message);
-                    cout << "Enter Notice Category: ";
-                    cin >> category;
-                    noticeBoard.addNotice(message, category);
-                    break;
-                }
-                case 2: {
-                    int id;
-                    string newMessage;
-                    cout << "Enter Notice ID: ";
-                    cin >> id;
-                    cout << "Enter New Message: ";
-                    cin.ignore();
-                    getline(cin, newMessage);
-                    noticeBoard.editNotice(id, newMessage);
-                    break;
-                }
-                case 3: {
-                    int id;
-                    cout << "Enter Notice ID: ";
-                    cin >> id;
-                    noticeBoard.deleteNotice(id);
+                    string path;
+                    cout << "Enter Payment File (student_id,amount per line): ";
+                    cin >> path;
+                    postPaymentFile(path);
                     break;
                 }
-                case 4:
-                    noticeBoard.viewNotices();
+                case 2:
+                    viewStudentsWithDues();
                     break;
-                case 5:
+                case 3:
                     cout << "Returning to main menu...\n";
                     break;
                 default:
                     cout << "Invalid choice! Please try again.\n";
             }
-        } while (choice != 5);
+        } while (choice != 3);
     }
 
-    void manageLibrary() {
-        int choice;
-        do {
-            cout << "\nLibrary Management Menu\n";
-            cout << "1. Add Book\n";
-            cout << "2. Remove Book\n";
-            cout << "3. Check Out Book\n";
-            cout << "4. Return Book\n";
-            cout << "5. View Books\n";
-            cout << "6. Back to Main Menu\n";
-            cout << "Enter your choice: ";
-            cin >> choice;
+    // Times logins through the username index against the old scan over every account, at growing user counts.
+    static void benchmarkLogin(size_t maxUsers) {
+        const size_t lookups = 200000, scans = 200;
+        cout << "Login latency (ns per login, half of the attempts use an unknown username):\n";
+        vector<size_t> counts;
+        for (size_t users = 1000; users < maxUsers; users *= 10) {
+            counts.push_back(users);
+        }
+        counts.push_back(max<size_t>(maxUsers, 1));
+        for (size_t users : counts) {
+            StudentInformationSystem sis(false);
+            {
+                OutputSilencer silencer;
+                for (size_t i = 0; i < users; ++i) {
+                    sis.addStudent("user" + to_string(i), "pw" + to_string(i), int(i + 1), 20, "N/A", 0);
+                }
+            }
+            vector<string> names(1024);
+            for (size_t i = 0; i < names.size(); ++i) {
+                size_t pick = (i * 2654435761u) % users;
+                names[i] = i % 2 ? "user" + to_string(pick) : "missing" + to_string(pick);
+            }
+            size_t found = 0;
+            auto start = chrono::steady_clock::now();
+            for (size_t i = 0; i < lookups; ++i) {
+                const string& name = names[i % names.size()];
+                found += sis.login(name, "pw" + name.substr(4)) != nullptr;
+            }
+            double indexed = chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / lookups;
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < scans; ++i) {
+                const string& name = names[i % names.size()];
+                string password = "pw" + name.substr(4);
+                for (auto& student : sis.students) {
+                    if (student.checkLogin(name, password)) {
+                        ++found;
+                        break;
+                    }
+                }
+            }
+            double scanned = chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / scans;
+            cout << "  " << users << " users: index " << size_t(indexed) << " ns, scan " << size_t(scanned) << " ns ("
+                 << found << " logins matched)\n";
+        }
+    }
 
-            switch (choice) {
-                case 1: {
-                    string book;
-                    cout << "Enter Book Name: ";
-                    cin >> book;
-                    library.addBook(book);
-                    break;
+    // Registers students through a scratch journal, replays it into a fresh system and compares the balances.
+    static bool checkJournalRoundTrip() {
+        const string logFile = "journal-check.log";
+        const vector<Cents> fees = {100050, 50000, 1, 0, 99999999};
+        StudentInformationSystem source(false), replica(false);
+        source.journal.open(logFile, 0, true);
+        source.ledger.setJournal(&source.journal);
+        {
+            OutputSilencer silencer;
+            for (size_t i = 0; i < fees.size(); ++i) {
+                source.addStudent("check" + to_string(i), "p", int(i + 1), 20, "N/A", fees[i]);
+            }
+            source.findStudent("check0")->makePayment(25);
+        }
+        source.journal.close();
+        ifstream inFile(logFile);
+        replica.replayRecords(inFile);
+        inFile.close();
+        remove(logFile.c_str());
+        bool ok = true;
+        for (size_t i = 0; i < fees.size(); ++i) {
+            Cents charged = 0, paid = 0, expectedCharged = 0, expectedPaid = 0;
+            source.ledger.balance(int(i + 1), expectedCharged, expectedPaid);
+            if (!replica.ledger.balance(int(i + 1), charged, paid) || charged != expectedCharged || paid != expectedPaid) {
+                cout << "Student " << i + 1 << ": journaled $" << formatMoney(expectedCharged) << " charged, $" << formatMoney(expectedPaid)
+                     << " paid; replayed $" << formatMoney(charged) << " charged, $" << formatMoney(paid) << " paid\n";
+                ok = false;
+            }
+        }
+        cout << (ok ? "Journal round trip matches for " : "Journal round trip failed for ") << fees.size() << " students.\n";
+        return ok;
+    }
+
+    // Posts the same payments one by one and in reconciliation batches, with and without a journal.
+    static void benchmarkFeePosting(size_t studentCount, size_t paymentCount, size_t batchSize) {
+        const string logFile = "fee-bench.log";
+        studentCount = max<size_t>(studentCount, 1);
+        batchSize = max<size_t>(batchSize, 1);
+        vector<FeeLedger::Payment> payments(paymentCount);
+        for (size_t i = 0; i < paymentCount; ++i) {
+            payments[i] = {int((i * 7919) % studentCount), Cents(1 + i % 5000)};
+        }
+        cout << "Posting " << paymentCount << " payments across " << studentCount << " accounts:\n";
+        for (int journaled = 0; journaled < 2; ++journaled) {
+            for (size_t batch : {size_t(1), batchSize}) {
+                FeeLedger ledger;
+                WriteAheadLog log;
+                for (size_t id = 0; id < studentCount; ++id) {
+                    ledger.openAccount(int(id), Cents(20000000));
                 }
-                case 2: {
-                    string book;
-                    cout << "Enter Book Name: ";
-                    cin >> book;
-                    library.removeBook(book);
-                    break;
+                if (journaled) {
+                    log.open(logFile, 0, true);
+                    ledger.setJournal(&log);
                 }
-                case 3: {
-                    string book, borrower;
-                    cout << "Enter Book Name: ";
-                    cin >> book;
-                    cout << "Enter Borrower Name: ";
-                    cin >> borrower;
-                    library.checkOutBook(book, borrower);
-                    break;
+                vector<FeeLedger::PostStatus> statuses;
+                auto start = chrono::steady_clock::now();
+                if (batch == 1) {
+                    for (const auto& payment : payments) {
+                        ledger.post(payment.studentId, payment.amount);
+                    }
+                } else {
+                    for (size_t first = 0; first < payments.size(); first += batch) {
+                        vector<FeeLedger::Payment> slice(payments.begin() + first, payments.begin() + min(payments.size(), first + batch));
+                        ledger.postBatch(slice, statuses);
+                    }
                 }
-                case 4: {
-                    string book, borrower;
-                    cout << "Enter Book Name: ";
-                    cin >> book;
-                    cout << "Enter Borrower Name: ";
-                    cin >> borrower;
-                    library.returnBook(book, borrower);
-                    break;
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                size_t dueCount;
+                Cents outstanding;
+                ledger.outstandingSummary(dueCount, outstanding);
+                cout << "  " << (journaled ? "journaled" : "in memory") << ", " << (batch == 1 ? string("single posts") : "batches of " + to_string(batch))
+                     << ": " << size_t(paymentCount / max(seconds, 1e-9)) << " payments/s (" << dueCount << " accounts due, $"
+                     << formatMoney(outstanding) << " outstanding)\n";
+                log.close();
+            }
+        }
+        remove(logFile.c_str());
+    }
+
+    // Takes a semester of attendance once per student entry and once per class session, with and without a journal.
+    static void benchmarkAttendance(size_t studentCount, size_t sessionsPerCourse) {
+        const string logFile = "attendance-bench.log";
+        const size_t courseCount = 40, coursesPerStudent = 5;
+        studentCount = max<size_t>(studentCount, 1);
+        auto attends = [](int studentId, size_t session) { return (uint32_t(studentId) * 2654435761u + session * 40503u) % 10 != 0; };
+        cout << "Recording " << sessionsPerCourse << " sessions in each of " << courseCount << " courses for "
+             << studentCount << " students:\n";
+        for (int journaled = 0; journaled < 2; ++journaled) {
+            for (int bySession = 0; bySession < 2; ++bySession) {
+                CourseRegistry catalog;
+                EnrollmentIndex enrollments;
+                Gradebook records(catalog);
+                WriteAheadLog log;
+                Faculty lecturer("bench", "", &catalog, &enrollments, &records);
+                vector<string> codes;
+                for (size_t course = 0; course < courseCount; ++course) {
+                    codes.push_back("C" + to_string(course));
+                    lecturer.assignCourse(codes.back(), "Course " + to_string(course));
                 }
-                case 5:
-                    library.viewBooks();
-                    break;
-                case 6:
-                    cout << "Returning to main menu ...\n";
-                    break;
-                default:
-                    cout << "Invalid choice! Please try again.\n";
+                for (size_t id = 0; id < studentCount; ++id) {
+                    for (size_t k = 0; k < coursesPerStudent; ++k) {
+                        CourseId course = CourseId((id + k * (courseCount / coursesPerStudent)) % courseCount);
+                        enrollments.enroll(int(id), course);
+                        records.initAttendance(int(id), course);
+                    }
+                }
+                vector<vector<int>> rosters;
+                for (size_t course = 0; course < courseCount; ++course) {
+                    rosters.push_back(enrollments.roster(CourseId(course)));
+                }
+                if (journaled) {
+                    log.open(logFile, 0, true);
+                    records.setJournal(&log);
+                }
+                size_t marks = 0;
+                auto start = chrono::steady_clock::now();
+                {
+                    OutputSilencer silencer;
+                    for (size_t session = 0; session < sessionsPerCourse; ++session) {
+                        for (size_t course = 0; course < courseCount; ++course) {
+                            if (bySession) {
+                                vector<int> present;
+                                for (int studentId : rosters[course]) {
+                                    if (attends(studentId, session)) {
+                                        present.push_back(studentId);
+                                    }
+                                }
+                                lecturer.recordSession(codes[course], "week-" + to_string(session), present);
+                            } else {
+                                // The only per-student path is a hand-entered percentage, re-entered after every class.
+                                for (int studentId : rosters[course]) {
+                                    lecturer.recordAttendance(studentId, codes[course], attends(studentId, session) ? 100 : 0);
+                                }
+                            }
+                            marks += rosters[course].size();
+                        }
+                    }
+                }
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                double total = 0;
+                size_t count = 0;
+                records.forEachAttendanceInCourses({0}, [&](int, const string&, int value) {
+                    total += value;
+                    ++count;
+                });
+                cout << "  " << (journaled ? "journaled" : "in memory") << ", " << (bySession ? "class sessions" : "per-student entries")
+                     << ": " << fixed << setprecision(2) << seconds << " s, " << size_t(marks / max(seconds, 1e-9)) << " marks/s, "
+                     << log.size() << " journal records";
+                if (bySession) {
+                    cout << ", mean attendance in " << codes[0] << " " << setprecision(1) << total / max<size_t>(count, 1) << "%";
+                }
+                cout << defaultfloat << "\n";
+                log.close();
+            }
+        }
+        remove(logFile.c_str());
+    }
+
+    // Summarizes one score array with the compiled-in kernel and with a plain loop, best of three runs each.
+    static void benchmarkGradeStatistics(size_t scoreCount) {
+        const float passMark = 40.0f;
+        vector<float> scores(max<size_t>(scoreCount, 1));
+        uint32_t state = 12345;
+        for (float& score : scores) {
+            state = state * 1664525u + 1013904223u;
+            score = float(state >> 8) / float(1u << 24) * 100.0f;
+        }
+        cout << "Summarizing " << scores.size() << " scores (kernel: " << GradeStatistics::kernel() << "):\n";
+        ScoreSummary simd = {}, plain = {};
+        double best = 1e30;
+        for (int run = 0; run < 3; ++run) {
+            auto start = chrono::steady_clock::now();
+            simd = GradeStatistics::summarize(scores.data(), scores.size(), passMark);
+            best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        }
+        cout << "  " << GradeStatistics::kernel() << ": " << size_t(scores.size() / max(best, 1e-9)) << " scores/s\n";
+        best = 1e30;
+        for (int run = 0; run < 3; ++run) {
+            auto start = chrono::steady_clock::now();
+            plain = {};
+            plain.count = scores.size();
+            double sum = 0.0, sumSquares = 0.0;
+            float low = scores[0], high = scores[0];
+            size_t passed = 0;
+            for (float v : scores) {
+                sum += v;
+                sumSquares += double(v) * v;
+                low = min(low, v);
+                high = max(high, v);
+                passed += v >= passMark;
+                ++plain.buckets[min(ScoreSummary::BUCKETS - 1, max(0, int(v / 10.0f)))];
+            }
+            plain.mean = sum / scores.size();
+            plain.stddev = sqrt(max(0.0, sumSquares / scores.size() - plain.mean * plain.mean));
+            plain.min = low;
+            plain.max = high;
+            plain.passRate = double(passed) / scores.size();
+            best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        }
+        cout << "  plain loop: " << size_t(scores.size() / max(best, 1e-9)) << " scores/s\n";
+        bool same = simd.min == plain.min && simd.max == plain.max && simd.passRate == plain.passRate &&
+                    fabs(simd.mean - plain.mean) < 1e-6 && fabs(simd.stddev - plain.stddev) < 1e-6 &&
+                    equal(simd.buckets, simd.buckets + ScoreSummary::BUCKETS, plain.buckets);
+        cout << "  Results " << (same ? "match" : "DIFFER") << " (mean " << simd.mean << ", pass rate " << simd.passRate * 100 << "%)\n";
+    }
+
+    // Indexes synthetic documents of Zipf-distributed words and reports median query latency by query shape.
+    static void benchmarkSearch(size_t docCount) {
+        const size_t vocabulary = 20000, wordsPerDoc = 12;
+        vector<double> cumulative(vocabulary);
+        double total = 0;
+        for (size_t rank = 0; rank < vocabulary; ++rank) {
+            total += 1.0 / (rank + 1);
+            cumulative[rank] = total;
+        }
+        uint64_t state = 88172645463325252ull;
+        auto nextWord = [&]() {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            double pick = double(state >> 11) / double(uint64_t(1) << 53) * total;
+            return size_t(lower_bound(cumulative.begin(), cumulative.end(), pick) - cumulative.begin());
+        };
+        SearchIndex index;
+        auto start = chrono::steady_clock::now();
+        string text;
+        for (size_t doc = 0; doc < docCount; ++doc) {
+            text.clear();
+            for (size_t w = 0; w < wordsPerDoc; ++w) {
+                text += "w" + to_string(nextWord()) + " ";
+            }
+            index.index(doc % 2 ? DocKind::Event : DocKind::Notice, int(doc / 2), text);
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Indexed " << index.documentCount() << " documents of " << wordsPerDoc << " words in " << fixed << setprecision(2)
+             << seconds << " s\n" << defaultfloat;
+        struct Shape {
+            string name;
+            vector<string> queries;
+        };
+        vector<Shape> shapes(4);
+        shapes[0].name = "two mid-frequency terms";
+        shapes[1].name = "two rare terms";
+        shapes[2].name = "most common term";
+        shapes[3].name = "two most common terms";
+        for (size_t q = 0; q < 200; ++q) {
+            shapes[0].queries.push_back("w" + to_string(20 + q % 80) + " w" + to_string(100 + (q * 7) % 400));
+            shapes[1].queries.push_back("w" + to_string(2000 + q * 31 % 15000) + " w" + to_string(3000 + q * 17 % 15000));
+        }
+        shapes[2].queries.assign(20, "w0");
+        shapes[3].queries.assign(20, "w0 w1");
+        for (const Shape& shape : shapes) {
+            vector<double> latencies;
+            size_t hits = 0;
+            for (const string& query : shape.queries) {
+                auto queryStart = chrono::steady_clock::now();
+                hits += index.search(query, 20).size();
+                latencies.push_back(chrono::duration<double>(chrono::steady_clock::now() - queryStart).count() * 1e6);
+            }
+            sort(latencies.begin(), latencies.end());
+            cout << "  " << shape.name << ": p50 " << fixed << setprecision(1) << latencies[latencies.size() / 2] << " us, p99 "
+                 << latencies[latencies.size() * 99 / 100] << " us (" << hits / shape.queries.size() << " hits per query)\n" << defaultfloat;
+        }
+#ifndef _WIN32
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            cout << "Peak RSS: " << usage.ru_maxrss / 1024 << " MB\n";
+        }
+#endif
+    }
+
+    // Stocks ten copies per title up to the requested volume count, then times checkout, loan lookup and return.
+    static void benchmarkLibrary(size_t volumeCount) {
+        const size_t copiesPerTitle = 10;
+        size_t titleCount = max<size_t>(volumeCount / copiesPerTitle, 1);
+        size_t borrowerCount = max<size_t>(volumeCount / 5, 1);
+        Library library;
+        vector<string> names(titleCount), borrowers(borrowerCount);
+        for (size_t t = 0; t < titleCount; ++t) {
+            names[t] = "Title " + to_string(t);
+        }
+        for (size_t b = 0; b < borrowerCount; ++b) {
+            borrowers[b] = "reader" + to_string(b);
+        }
+        auto perOp = [](chrono::steady_clock::time_point start, size_t ops) {
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / max<size_t>(ops, 1);
+        };
+        double addNs, checkoutNs, lookupNs, returnNs;
+        size_t loaned = 0, held = 0, returned = 0;
+        {
+            // Every Library operation reports to cout, so the silencer's cost is part of each figure.
+            OutputSilencer silencer;
+            auto start = chrono::steady_clock::now();
+            for (size_t copy = 0; copy < copiesPerTitle; ++copy) {
+                for (size_t t = 0; t < titleCount; ++t) {
+                    library.addBook(names[t], copy == 0 ? "978" + to_string(t) : "");
+                }
+            }
+            addNs = perOp(start, titleCount * copiesPerTitle);
+            // Half of the volumes go out on loan, spread pseudo-randomly over titles and round-robin over borrowers.
+            size_t loansWanted = titleCount * copiesPerTitle / 2;
+            vector<pair<size_t, size_t>> loanList;
+            loanList.reserve(loansWanted);
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < loansWanted; ++i) {
+                size_t t = (i * 2654435761u) % titleCount, b = i % borrowerCount;
+                if (library.checkOutBook(names[t], borrowers[b])) {
+                    loanList.push_back({t, b});
+                }
+            }
+            checkoutNs = perOp(start, loansWanted);
+            loaned = loanList.size();
+            start = chrono::steady_clock::now();
+            for (size_t b = 0; b < borrowerCount; ++b) {
+                held += library.loansOf(borrowers[(b * 40503u) % borrowerCount]).size();
+            }
+            lookupNs = perOp(start, borrowerCount);
+            start = chrono::steady_clock::now();
+            for (const auto& loan : loanList) {
+                returned += library.returnBook(names[loan.first], borrowers[loan.second]);
+            }
+            returnNs = perOp(start, loanList.size());
+        }
+        cout << "Library of " << titleCount * copiesPerTitle << " volumes (" << titleCount << " titles x " << copiesPerTitle
+             << " copies, " << borrowerCount << " borrowers):\n";
+        cout << "  add: " << size_t(addNs) << " ns\n";
+        cout << "  checkout: " << size_t(checkoutNs) << " ns (" << loaned << " loans)\n";
+        cout << "  loan lookup: " << size_t(lookupNs) << " ns (" << held << " books held)\n";
+        cout << "  return: " << size_t(returnNs) << " ns (" << returned << " returned)\n";
+#ifndef _WIN32
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            cout << "Peak RSS: " << usage.ru_maxrss / 1024 << " MB\n";
+        }
+#endif
+    }
+
+    bool writeListing(const string& listing, ListingFormat format, OutputSink& out) const {
+        if (listing == "students") {
+            ListingEncoder encoder(out, format, {"id", "username", "age", "program", "fee", "paid"});
+            for (const Student* student : studentsById()) {
+                encoder.field(student->getId()).field(student->getUsername()).field(student->getAge())
+                       .field(student->getCourse()).field(formatMoney(student->getFeeAmount())).field(formatMoney(student->getPaidAmount()));
+            }
+            encoder.finish();
+        } else if (listing == "notices") {
+            ListingEncoder encoder(out, format, {"id", "timestamp", "category", "message"});
+            for (const auto& notice : *noticeBoard.snapshot()) {
+                encoder.field(notice.id).field(notice.getTimestamp()).field(notice.category).field(notice.message);
+            }
+            encoder.finish();
+        } else if (listing == "events") {
+            ListingEncoder encoder(out, format, {"id", "name", "description", "date", "time", "duration", "location", "scheduled"});
+            for (const auto& event : *eventManagementSystem.snapshot()) {
+                encoder.field(event.id).field(event.name).field(event.description).field(event.date).field(event.time)
+                       .field(event.duration).field(event.location).field(event.scheduled);
+            }
+            encoder.finish();
+        } else if (listing == "books") {
+            ListingEncoder encoder(out, format, {"title", "isbn", "available", "owned"});
+            for (const auto& book : *library.snapshot()) {
+                encoder.field(book.name).field(book.isbn).field(book.available).field(book.owned);
+            }
+            encoder.finish();
+        } else if (listing == "rooms") {
+            ListingEncoder encoder(out, format, {"room", "student"});
+            for (const auto& assignment : hostel.snapshot()->assignments) {
+                encoder.field(assignment.first).field(assignment.second);
+            }
+            encoder.finish();
+        } else if (listing == "courses") {
+            ListingEncoder encoder(out, format, {"id", "code", "name"});
+            for (CourseId id = 0; id < catalog.size(); ++id) {
+                encoder.field(id).field(catalog.code(id)).field(catalog.course(id).getCourseName());
+            }
+            encoder.finish();
+        } else if (listing == "dues") {
+            ListingEncoder encoder(out, format, {"student_id", "due"});
+            for (const auto& entry : ledger.studentsWithDues()) {
+                encoder.field(entry.first).field(formatMoney(entry.second));
+            }
+            encoder.finish();
+        } else if (listing == "grades") {
+            shared_ptr<const Gradebook::FinalGradeView> view = records.finalGradeSnapshot();
+            vector<CourseId> courses(view->size());
+            for (size_t i = 0; i < courses.size(); ++i) {
+                courses[i] = CourseId(i);
+            }
+            ListingEncoder encoder(out, format, {"student_id", "course", "grade"});
+            for (const auto& row : Gradebook::selectFinalGrades(*view, courses)) {
+                encoder.field(row.studentId).field(row.courseCode).field(row.grade);
             }
-        } while (choice != 6);
+            encoder.finish();
+        } else {
+            return false;
+        }
+        return true;
     }
 
-    void manageHostel() {
+    bool exportListing(const string& listing, const string& formatName, ostream& target) const {
+        ListingFormat format;
+        if (!parseListingFormat(formatName, format)) {
+            cout << "Unknown export format: " << formatName << " (expected json or csv)\n";
+            return false;
+        }
+        StreamSink out(target);
+        if (!writeListing(listing, format, out)) {
+            cout << "Unknown listing: " << listing << " (expected students, courses, notices, events, books, rooms, dues or grades)\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool exportListing(const string& listing, const string& formatName, const string& path) const {
+        if (path == "-") {
+            return exportListing(listing, formatName, cout);
+        }
+        ofstream outFile(path, ios::binary);
+        if (!outFile) {
+            cout << "Cannot open export file " << path << "\n";
+            return false;
+        }
+        if (!exportListing(listing, formatName, outFile)) {
+            return false;
+        }
+        if (!outFile.flush()) {
+            cout << "Failed to write export file " << path << "\n";
+            return false;
+        }
+        cout << "Exported " << listing << " to " << path << "\n";
+        return true;
+    }
+
+    void manageReports() {
         int choice;
         do {
-            cout << "\nHostel Management Menu\n";
-            cout << "1. Add Room\n";
-            cout << "2. Assign Room\n";
-            cout << "3. View Rooms\n";
-            cout << "4. View Room Assignments\n";
-            cout << "5. Back to Main Menu\n";
+            cout << "\nReports Menu\n";
+            cout << "1. Memory Footprint\n";
+            cout << "2. Grade Statistics\n";
+            cout << "3. Generate Transcripts\n";
+            cout << "4. Transcript Scaling\n";
+            cout << "5. Export Listing\n";
+            cout << "6. Dashboard\n";
+            cout << "7. Check Dashboard Aggregates\n";
+            cout << "8. Back to Main Menu\n";
             cout << "Enter your choice: ";
             cin >> choice;
 
             switch (choice) {
-                case 1: {
-                    string room;
-                    cout << "Enter Room Number: ";
-                    cin >> room;
-                    hostel.addRoom(room);
+                case 1:
+                    reportMemoryFootprint();
+                    break;
+                case 2:
+                    reportGradeStatistics();
+                    break;
+                case 3: {
+                    string path;
+                    cout << "Enter Output File (end with / for one file per student): ";
+                    cin >> path;
+                    generateTranscripts(path, max(1u, thread::hardware_concurrency()));
                     break;
                 }
-                case 2: {
-                    string room, student;
-                    cout << "Enter Room Number: ";
-                    cin >> room;
-                    cout << "Enter Student Name: ";
-                    cin >> student;
-                    hostel.assignRoom(room, student);
+                case 4:
+                    reportTranscriptScaling();
+                    break;
+                case 5: {
+                    string listing, format, path;
+                    cout << "Enter Listing (students, courses, notices, events, books, rooms, dues, grades): ";
+                    cin >> listing;
+                    cout << "Enter Format (json or csv): ";
+                    cin >> format;
+                    cout << "Enter Output File (- for screen): ";
+                    cin >> path;
+                    exportListing(listing, format, path);
                     break;
                 }
-                case 3:
-                    hostel.viewRooms();
+                case 6:
+                    viewDashboard();
                     break;
-                case 4:
-                    hostel.viewRoomAssignments();
+                case 7:
+                    checkAggregates();
                     break;
-                case 5:
+                case 8:
                     cout << "Returning to main menu...\n";
                     break;
                 default:
                     cout << "Invalid choice! Please try again.\n";
             }
-        } while (choice != 5);
+        } while (choice != 8);
     }
 
-    void manageEvents() {
-        int choice;
-        do {
-            cout << "\nEvent Management Menu\n";
-            cout << "1. Add Event\n";
-            cout << "2. Edit Event\n";
-            cout << "3. Delete Event\n";
-            cout << "4. View Events\n";
-            cout << "5. Back to Main Menu\n";
-            cout << "Enter your choice: ";
-            cin >> choice;
+    static bool parseDate(const string& text, time_t& out) {
+        return parseLocalTime(text, "00:00", out);
+    }
 
-            switch (choice) {
-                case 1: {
-                    string name, description, date, time, location;
-                    cout << "Enter Event Name: ";
-                    cin.ignore();
-                    getline(cin, name);
-                    cout << "Enter Event Description: ";
-                    getline(cin, description);
-                    cout << "Enter Event Date: ";
-                    cin >> date;
-                    cout << "Enter Event Time: ";
-                    cin >> time;
-                    cout << "Enter Event Location: ";
-                    cin >> location;
-                    eventManagementSystem.addEvent(name, description, date, time, location);
-                    break;
+    static Cents money(const string& text) {
+        Cents amount;
+        if (!parseMoney(text, amount)) {
+            throw invalid_argument("amount");
+        }
+        return amount;
+    }
+
+    static string eventIds(const vector<const Event*>& selection) {
+        string ids;
+        for (const Event* event : selection) {
+            ids += "\t" + to_string(event->id);
+        }
+        return ids;
+    }
+
+    static string noticeIds(const vector<const Notice*>& selection) {
+        string ids;
+        for (const Notice* notice : selection) {
+            ids += "\t" + to_string(notice->id);
+        }
+        return ids;
+    }
+
+    string executeCommand(const vector<string>& f) {
+        const string& command = f[0];
+        if (isReportCommand(command)) {
+            return executeReport(f, false);
+        }
+        if (command == "register-student" && f.size() == 6) {
+            return addStudent(f[1], f[2], stoi(f[3]), stoi(f[4]), "N/A", money(f[5])) ? "ok" : "error\tduplicate username or student id";
+        } else if (command == "register-faculty" && f.size() == 3) {
+            return addFaculty(f[1], f[2]) ? "ok" : "error\tduplicate username";
+        } else if (command == "enroll" && f.size() == 4) {
+            Student* student = findStudent(f[1]);
+            if (!student) return "error\tunknown student";
+            return student->addCourse(f[2], f[3]) ? "ok" : "error\talready enrolled";
+        } else if (command == "pay" && f.size() == 3) {
+            Student* student = findStudent(f[1]);
+            if (!student) return "error\tunknown student";
+            return student->makePayment(money(f[2])) ? "ok" : "error\tpayment rejected";
+        } else if (command == "fees" && f.size() == 2) {
+            Student* student = findStudent(f[1]);
+            if (!student) return "error\tunknown student";
+            return "ok\t" + formatMoney(student->getFeeAmount()) + "\t" + formatMoney(student->getPaidAmount());
+        } else if (command == "roster" && f.size() == 2) {
+            CourseId course;
+            if (!catalog.find(f[1], course)) return "error\tunknown course";
+            string result = "ok\t" + to_string(enrollments.headcount(course));
+            for (int studentId : enrollments.roster(course)) {
+                result += "\t" + to_string(studentId);
+            }
+            return result;
+        } else if (command == "instructors" && f.size() == 2) {
+            Student* student = findStudent(f[1]);
+            if (!student) return "error\tunknown student";
+            string result = "ok";
+            for (const auto& name : enrollments.facultyOf(student->getId())) {
+                result += "\t" + name;
+            }
+            return result;
+        } else if (command == "faculty-students" && f.size() == 2) {
+            if (!findFaculty(f[1])) return "error\tunknown faculty";
+            string result = "ok";
+            for (int studentId : enrollments.studentsOf(f[1])) {
+                result += "\t" + to_string(studentId);
+            }
+            return result;
+        } else if (command == "dashboard" && f.size() == 1) {
+            size_t dueCount;
+            Cents outstanding;
+            ledger.outstandingSummary(dueCount, outstanding);
+            return "ok\t" + to_string(students.size()) + "\t" + to_string(records.lowAttendanceCount()) + "\t"
+                 + to_string(dueCount) + "\t" + formatMoney(outstanding);
+        } else if (command == "low-attendance" && f.size() <= 2) {
+            vector<int> low = records.lowAttendanceStudents();
+            size_t limit = f.size() == 2 ? stoul(f[1]) : low.size();
+            string result = "ok\t" + to_string(low.size());
+            for (size_t i = 0; i < low.size() && i < limit; ++i) {
+                result += "\t" + to_string(low[i]);
+            }
+            return result;
+        } else if (command == "course-average" && f.size() == 2) {
+            CourseId course;
+            Gradebook::GradeAverage average;
+            if (!catalog.find(f[1], course) || !records.finalGradeAverage(course, average)) {
+                return "error\tno final grades for course";
+            }
+            return "ok\t" + to_string(average.mean) + "\t" + to_string(average.count);
+        } else if (command == "check-aggregates" && f.size() == 1) {
+            vector<string> problems;
+            records.verifyAggregates(problems);
+            ledger.verifyTotals(problems);
+            return problems.empty() ? "ok" : "error\t" + problems.front();
+        } else if (command == "dues" && f.size() <= 2) {
+            vector<pair<int, Cents>> dues = ledger.studentsWithDues();
+            size_t limit = f.size() == 2 ? stoul(f[1]) : dues.size();
+            string result = "ok";
+            for (size_t i = 0; i < dues.size() && i < limit; ++i) {
+                result += "\t" + to_string(dues[i].first) + ":" + formatMoney(dues[i].second);
+            }
+            return result;
+        } else if (command == "teach" && f.size() == 4) {
+            Faculty* member = findFaculty(f[1]);
+            if (!member) return "error\tunknown faculty";
+            member->assignCourse(f[2], f[3]);
+            return "ok";
+        } else if (command == "attendance" && f.size() == 5) {
+            Faculty* member = findFaculty(f[1]);
+            if (!member) return "error\tunknown faculty";
+            return member->recordAttendance(stoi(f[2]), f[3], stoi(f[4])) ? "ok" : "error\tcourse not assigned or student not enrolled";
+        } else if (command == "session" && f.size() >= 4) {
+            Faculty* member = findFaculty(f[1]);
+            if (!member) return "error\tunknown faculty";
+            vector<int> present;
+            for (size_t i = 4; i < f.size(); ++i) {
+                present.push_back(stoi(f[i]));
+            }
+            return member->recordSession(f[2], f[3], present) ? "ok" : "error\tcourse not assigned";
+        } else if (command == "score" && f.size() == 6) {
+            Faculty* member = findFaculty(f[1]);
+            if (!member) return "error\tunknown faculty";
+            return member->recordExamScore(stoi(f[2]), f[3], f[4], stof(f[5])) ? "ok" : "error\tcourse not assigned";
+        } else if (command == "grade" && f.size() == 5) {
+            Faculty* member = findFaculty(f[1]);
+            if (!member) return "error\tunknown faculty";
+            return member->assignFinalGrade(stoi(f[2]), f[3], stof(f[4])) ? "ok" : "error\tcourse not assigned";
+        } else if (command == "notice-add" && f.size() == 3) {
+            return "ok\t" + to_string(noticeBoard.addNotice(f[2], f[1]));
+        } else if (command == "notice-edit" && f.size() == 3) {
+            return noticeBoard.editNotice(stoi(f[1]), f[2]) ? "ok" : "error\tnotice not found";
+        } else if (command == "notice-delete" && f.size() == 2) {
+            return noticeBoard.deleteNotice(stoi(f[1])) ? "ok" : "error\tnotice not found";
+        } else if (command == "notice-since" && f.size() == 3) {
+            time_t since;
+            if (!parseDate(f[2], since)) return "error\tinvalid date";
+            return "ok" + noticeIds(noticeBoard.noticesSince(f[1], since));
+        } else if (command == "notice-latest" && f.size() == 2) {
+            return "ok" + noticeIds(noticeBoard.latestNotices(stoul(f[1])));
+        } else if (command == "search" && f.size() == 2) {
+            string result = "ok";
+            for (const auto& hit : searchIndex.search(f[1], 20)) {
+                result += (hit.kind == DocKind::Notice ? "\tnotice:" : "\tevent:") + to_string(hit.id);
+            }
+            return result;
+        } else if (command == "book-add" && (f.size() == 2 || f.size() == 3)) {
+            return library.addBook(f[1], f.size() == 3 ? f[2] : "") ? "ok" : "error\tisbn belongs to another title";
+        } else if (command == "book-remove" && f.size() == 2) {
+            return library.removeBook(f[1]) ? "ok" : "error\tbook not found";
+        } else if (command == "book-checkout" && f.size() == 3) {
+            return library.checkOutBook(f[1], f[2]) ? "ok" : "error\tbook not found";
+        } else if (command == "book-return" && f.size() == 3) {
+            return library.returnBook(f[1], f[2]) ? "ok" : "error\tno such loan";
+        } else if (command == "book-loans" && f.size() == 2) {
+            string result = "ok";
+            for (const auto& book : library.loansOf(f[1])) {
+                result += "\t" + book;
+            }
+            return result;
+        } else if (command == "room-add" && (f.size() == 2 || f.size() == 3)) {
+            return hostel.addRoom(f[1], f.size() == 3 ? stoul(f[2]) : 1) ? "ok" : "error\tduplicate room or zero capacity";
+        } else if (command == "room-assign" && f.size() == 3) {
+            return hostel.assignRoom(f[1], f[2]) ? "ok" : "error\troom not found, full or student already housed";
+        } else if (command == "room-auto" && f.size() == 1) {
+            return "ok\t" + to_string(autoAssignRooms());
+        } else if (command == "room-free" && f.size() == 1) {
+            string room;
+            uint32_t bed;
+            if (!hostel.firstFreeBed(room, bed)) return "error\tno free beds";
+            return "ok\t" + room + "\t" + to_string(bed);
+        } else if (command == "event-add" && (f.size() == 6 || f.size() == 7)) {
+            int id = eventManagementSystem.addEvent(f[1], f[2], f[3], f[4], f[5], f.size() == 7 ? stoi(f[6]) : 60);
+            return id ? "ok\t" + to_string(id) : "error\tinvalid time or venue already booked";
+        } else if (command == "event-edit" && (f.size() == 7 || f.size() == 8)) {
+            return eventManagementSystem.editEvent(stoi(f[1]), f[2], f[3], f[4], f[5], f[6], f.size() == 8 ? stoi(f[7]) : 60)
+                ? "ok" : "error\tevent not found, invalid time or venue already booked";
+        } else if (command == "event-free" && f.size() == 5) {
+            time_t start;
+            if (!parseLocalTime(f[2], f[3], start)) return "error\tinvalid date or time";
+            int conflict = eventManagementSystem.venueConflict(f[1], start, stoi(f[4]));
+            return conflict ? "ok\tbusy\t" + to_string(conflict) : "ok\tfree";
+        } else if (command == "event-window" && f.size() == 5) {
+            time_t from, to;
+            if (!parseLocalTime(f[1], f[2], from) || !parseLocalTime(f[3], f[4], to)) return "error\tinvalid date or time";
+            return "ok" + eventIds(eventManagementSystem.eventsInWindow(from, to));
+        } else if (command == "event-next" && f.size() == 2) {
+            return "ok" + eventIds(eventManagementSystem.upcomingEvents(time(0), stoul(f[1])));
+        } else if (command == "event-delete" && f.size() == 2) {
+            return eventManagementSystem.deleteEvent(stoi(f[1])) ? "ok" : "error\tevent not found";
+        } else if (command == "compact" && f.size() == 1) {
+            return compact() ? "ok" : "error\tsnapshot write failed";
+        }
+        return "error\tunknown command or wrong argument count";
+    }
+
+    bool importCsv(const string& kindName, const string& path) {
+        ImportKind kind;
+        if (!CsvImporter::parseKind(kindName, kind)) {
+            cout << "Unknown import kind: " << kindName << " (expected students, faculty, enrollments, attendance or scores)\n";
+            return false;
+        }
+        ifstream inFile(path);
+        if (!inFile) {
+            cout << "Cannot open import file " << path << "\n";
+            return false;
+        }
+        journal.suspend();
+        auto commit = [&](const ImportRow& row) -> bool {
+            switch (kind) {
+                case ImportKind::Students:
+                    return addStudent(row.text1, row.text2, row.id, row.age, row.text3, row.money);
+                case ImportKind::Faculty:
+                    return addFaculty(row.text1, row.text2);
+                case ImportKind::Enrollments: {
+                    auto it = studentIndex.find(row.id);
+                    if (it == studentIndex.end()) {
+                        return false;
+                    }
+                    return it->second->addCourse(row.text1, row.text2);
                 }
-                case 2: {
-                    int id;
-                    string newName, newDescription, newDate, newTime, newLocation;
-                    cout << "Enter Event ID: ";
-                    cin >> id;
-                    cout << "Enter New Event Name: ";
-                    cin.ignore();
-                    getline(cin, newName);
-                    cout << "Enter New Event Description: ";
-                    getline(cin, newDescription);
-                    cout << "Enter New Event Date: ";
-                    cin >> newDate;
-                    cout << "Enter New Event Time: ";
-                    cin >> newTime;
-                    cout << "Enter New Event Location: ";
-                    cin >> newLocation;
-                    eventManagementSystem.editEvent(id, newName, newDescription, newDate, newTime, newLocation);
-                    break;
+                case ImportKind::Attendance: {
+                    CourseId course;
+                    if (!catalog.find(row.text1, course) || !enrollments.contains(row.id, course)) {
+                        return false;
+                    }
+                    records.recordAttendance(row.id, course, row.age);
+                    return true;
                 }
-                case 3: {
-                    int id;
-                    cout << "Enter Event ID: ";
-                    cin >> id;
-                    eventManagementSystem.deleteEvent(id);
-                    break;
+                case ImportKind::Scores:
+                    if (!studentIndex.count(row.id)) {
+                        return false;
+                    }
+                    records.recordExamScore(row.id, row.text1, row.text2, row.number);
+                    return true;
+            }
+            return false;
+        };
+        size_t rowsRead = 0, rowsRejected = 0;
+        auto start = chrono::steady_clock::now();
+        CsvImporter(kind).run(inFile, commit, rowsRead, rowsRejected);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        // The journal was suspended, so the snapshot is the only copy of the imported rows.
+        if (!compact()) {
+            cerr << "Import of " << rowsRead - rowsRejected << " " << kindName << " rows was not saved.\n";
+            return false;
+        }
+        cout << "Imported " << rowsRead - rowsRejected << " of " << rowsRead << " " << kindName << " rows ("
+             << rowsRejected << " rejected) in " << seconds << " s";
+        if (seconds > 0) {
+            cout << " (" << size_t(rowsRead / seconds) << " rows/s)";
+        }
+        cout << "\n";
+#ifndef _WIN32
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            cout << "Peak RSS: " << usage.ru_maxrss / 1024 << " MB\n";
+        }
+#endif
+        return true;
+    }
+
+    User* authenticate(const string& username, const string& password) const {
+        shared_lock<shared_timed_mutex> people(domainLock(Domain::People));
+        auto it = userIndex.find(username);
+        if (it != userIndex.end() && it->second->checkLogin(username, password)) {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    template <typename Take>
+    auto pinSnapshot(Domain domain, bool lock, Take take) const -> decltype(take()) {
+        if (!lock) {
+            return take();
+        }
+        shared_lock<shared_timed_mutex> guard(domainLock(domain));
+        return take();
+    }
+
+    static bool isReportCommand(const string& command) {
+        return command == "notices" || command == "events" || command == "books" || command == "rooms" || command == "grades";
+    }
+
+    string executeReport(const vector<string>& f, bool lock) const {
+        string result = "ok";
+        if (f[0] == "notices" && f.size() == 1) {
+            auto view = pinSnapshot(Domain::Board, lock, [&] { return noticeBoard.snapshot(); });
+            for (const auto& notice : *view) {
+                result += "\t" + to_string(notice.id);
+            }
+        } else if (f[0] == "events" && f.size() == 1) {
+            auto view = pinSnapshot(Domain::Board, lock, [&] { return eventManagementSystem.snapshot(); });
+            for (const auto& event : *view) {
+                result += "\t" + to_string(event.id);
+            }
+        } else if (f[0] == "books" && f.size() == 1) {
+            auto view = pinSnapshot(Domain::Books, lock, [&] { return library.snapshot(); });
+            for (const auto& book : *view) {
+                result += "\t" + book.name + ":" + to_string(book.available) + "/" + to_string(book.owned);
+            }
+        } else if (f[0] == "rooms" && f.size() == 1) {
+            auto view = pinSnapshot(Domain::Rooms, lock, [&] { return hostel.snapshot(); });
+            for (const auto& assignment : view->assignments) {
+                result += "\t" + assignment.first + ":" + assignment.second;
+            }
+        } else if (f[0] == "grades" && f.size() == 2) {
+            vector<CourseId> courses;
+            auto view = pinSnapshot(Domain::People, lock, [&] {
+                Faculty* member = findFaculty(f[1]);
+                if (member) {
+                    courses = member->assignedCourseIds();
                 }
-                case 4:
-                    eventManagementSystem.viewEvents();
-                    break;
-                case 5:
-                    cout << "Returning to main menu...\n";
-                    break;
-                default:
-                    cout << "Invalid choice! Please try again.\n";
+                return records.finalGradeSnapshot();
+            });
+            for (const auto& row : Gradebook::selectFinalGrades(*view, courses)) {
+                result += "\t" + to_string(row.studentId) + ":" + row.courseCode + ":" + to_string(row.grade);
+            }
+        } else {
+            return "error\tunknown command";
+        }
+        return result;
+    }
+
+    string executeShared(const vector<string>& f) {
+        if (isReportCommand(f[0])) {
+            return executeReport(f, true);
+        }
+        CommandAccess access;
+        if (!commandAccess(f[0], access)) {
+            return "error\tunknown command";
+        }
+        string result;
+        try {
+            if (f[0] == "room-auto") {
+                shared_lock<shared_timed_mutex> people(domainLock(Domain::People));
+                unique_lock<shared_timed_mutex> rooms(domainLock(Domain::Rooms));
+                result = executeCommand(f);
+            } else if (access.write && !access.perUser) {
+                unique_lock<shared_timed_mutex> lock(domainLock(access.domain));
+                result = executeCommand(f);
+            } else if (access.domain == Domain::People && f.size() > 1) {
+                shared_lock<shared_timed_mutex> people(domainLock(Domain::People));
+                lock_guard<mutex> user(userStripe(f[1]));
+                result = executeCommand(f);
+            } else {
+                shared_lock<shared_timed_mutex> lock(domainLock(access.domain));
+                result = executeCommand(f);
+            }
+        } catch (const exception&) {
+            result = "error\tinvalid argument";
+        }
+        if (persistent && journal.size() >= compactThreshold) {
+            compactShared();
+        }
+        return result;
+    }
+
+    bool runBatch(const string& path, ostream& results) {
+        ifstream inFile;
+        if (path != "-") {
+            inFile.open(path);
+            if (!inFile) {
+                cerr << "Cannot open batch file " << path << "\n";
+                return false;
+            }
+        }
+        istream& in = path == "-" ? cin : inFile;
+        size_t commands = 0, failures = 0;
+        auto start = chrono::steady_clock::now();
+        string line;
+        while (getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#') {
+                continue;
             }
-        } while (choice != 5);
+            string result;
+            try {
+                result = executeCommand(WriteAheadLog::split(line));
+            } catch (const exception&) {
+                result = "error\tinvalid argument";
+            }
+            ++commands;
+            if (result.compare(0, 5, "error") == 0) {
+                ++failures;
+            }
+            results << commands << '\t' << result << '\n';
+            compactIfNeeded();
+        }
+        results.flush();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cerr << "Processed " << commands << " commands (" << failures << " failed) in " << seconds << " s";
+        if (seconds > 0) {
+            cerr << " (" << size_t(commands / seconds) << " ops/s)";
+        }
+        cerr << "\n";
+        return true;
+    }
+
+    void searchNoticesAndEvents(const string& query) const {
+        StreamSink out(cout);
+        vector<SearchHit> hits = searchIndex.search(query, 20);
+        if (hits.empty()) {
+            out << "No matching notices or events.\n";
+            return;
+        }
+        out << "Search Results:\n";
+        for (const auto& hit : hits) {
+            if (hit.kind == DocKind::Notice) {
+                if (const Notice* notice = noticeBoard.getNotice(hit.id)) {
+                    NoticeBoard::printNotice(*notice, out);
+                }
+            } else if (const Event* event = eventManagementSystem.getEvent(hit.id)) {
+                event->displayEvent(out);
+                out << "-------------------------\n";
+            }
+        }
     }
 
     void run() {
@@ -1012,7 +6825,10 @@ public:
             cout << "5. Manage Library\n";
             cout << "6. Manage Hostel\n";
             cout << "7. Manage Events\n";
-            cout << "8. Exit\n";
+            cout << "8. Search Notices and Events\n";
+            cout << "9. Reports\n";
+            cout << "10. Manage Fees\n";
+            cout << "11. Exit\n";
             cout << "Enter your choice: ";
             cin >> choice;
 
@@ -1049,17 +6865,340 @@ public:
                 case 7:
                     manageEvents();
                     break;
-                case 8:
+                case 8: {
+                    string query;
+                    cout << "Enter Search Terms: ";
+                    cin.ignore();
+                    getline(cin, query);
+                    searchNoticesAndEvents(query);
+                    break;
+                }
+                case 9:
+                    manageReports();
+                    break;
+                case 10:
+                    manageFees();
+                    break;
+                case 11:
                     cout << "Exiting...\n";
                     return;
                 default:
                     cout << "Invalid choice! Please try again.\n";
             }
+            compactIfNeeded();
         } while (true);
     }
 };
 
-int main() {
+class SessionServer {
+public:
+    struct Request {
+        string session;
+        vector<string> fields;
+        size_t tag;
+        chrono::steady_clock::time_point submitted;
+    };
+
+    typedef function<void(const Request&, const string&)> Completion;
+
+private:
+    struct Session {
+        string username;
+        string role;
+    };
+
+    struct Worker {
+        mutex lock;
+        condition_variable ready;
+        deque<Request> queue;
+        unordered_map<string, Session> sessions;
+        bool stopping = false;
+        thread runner;
+    };
+
+    StudentInformationSystem& sis;
+    vector<unique_ptr<Worker>> workers;
+    Completion onComplete;
+    atomic<size_t> pending;
+    mutex idleLock;
+    condition_variable idle;
+
+    string handle(Worker& worker, const Request& request) {
+        const vector<string>& f = request.fields;
+        if (f.empty() || f[0].empty()) {
+            return "error\tempty command";
+        }
+        if (f[0] == "login" && f.size() == 3) {
+            User* user = sis.authenticate(f[1], f[2]);
+            if (!user) {
+                return "error\tinvalid login credentials";
+            }
+            worker.sessions[request.session] = {user->getUsername(), user->getRole()};
+            return "ok\t" + user->getRole();
+        }
+        if (f[0] == "logout" && f.size() == 1) {
+            return worker.sessions.erase(request.session) ? "ok" : "error\tnot logged in";
+        }
+        static const unordered_map<string, string> personal = {
+            {"enroll", "student"}, {"pay", "student"}, {"fees", "student"},
+            {"teach", "faculty"}, {"attendance", "faculty"}, {"score", "faculty"}, {"grade", "faculty"},
+            {"session", "faculty"},
+        };
+        auto role = personal.find(f[0]);
+        if (role == personal.end()) {
+            return sis.executeShared(f);
+        }
+        auto session = worker.sessions.find(request.session);
+        if (session == worker.sessions.end() || session->second.role != role->second) {
+            return "error\tlogin as " + role->second + " required";
+        }
+        vector<string> scoped(f);
+        scoped.insert(scoped.begin() + 1, session->second.username);
+        return sis.executeShared(scoped);
+    }
+
+    void work(Worker& worker) {
+        while (true) {
+            Request request;
+            {
+                unique_lock<mutex> guard(worker.lock);
+                worker.ready.wait(guard, [&] { return worker.stopping || !worker.queue.empty(); });
+                if (worker.queue.empty()) {
+                    return;
+                }
+                request = move(worker.queue.front());
+                worker.queue.pop_front();
+            }
+            string result = handle(worker, request);
+            onComplete(request, result);
+            if (--pending == 0) {
+                lock_guard<mutex> guard(idleLock);
+                idle.notify_all();
+            }
+        }
+    }
+
+public:
+    SessionServer(StudentInformationSystem& system, size_t threads, Completion completion)
+        : sis(system), onComplete(completion), pending(0) {
+        for (size_t i = 0; i < max<size_t>(1, threads); ++i) {
+            workers.emplace_back(new Worker);
+        }
+        for (auto& worker : workers) {
+            Worker* w = worker.get();
+            w->runner = thread([this, w] { work(*w); });
+        }
+    }
+
+    ~SessionServer() {
+        drain();
+        for (auto& worker : workers) {
+            {
+                lock_guard<mutex> guard(worker->lock);
+                worker->stopping = true;
+            }
+            worker->ready.notify_all();
+        }
+        for (auto& worker : workers) {
+            worker->runner.join();
+        }
+    }
+
+    SessionServer(const SessionServer&) = delete;
+    SessionServer& operator=(const SessionServer&) = delete;
+
+    size_t threadCount() const { return workers.size(); }
+
+    void submit(const string& session, vector<string> fields, size_t tag = 0) {
+        Worker& worker = *workers[hash<string>()(session) % workers.size()];
+        ++pending;
+        {
+            lock_guard<mutex> guard(worker.lock);
+            worker.queue.push_back({session, move(fields), tag, chrono::steady_clock::now()});
+        }
+        worker.ready.notify_one();
+    }
+
+    void drain() {
+        unique_lock<mutex> guard(idleLock);
+        idle.wait(guard, [&] { return pending == 0; });
+    }
+
+    static size_t defaultThreads() {
+        return max(4u, thread::hardware_concurrency());
+    }
+
+    static bool serve(StudentInformationSystem& sis, const string& path, ostream& results) {
+        ifstream inFile;
+        if (path != "-") {
+            inFile.open(path);
+            if (!inFile) {
+                cerr << "Cannot open session file " << path << "\n";
+                return false;
+            }
+        }
+        istream& in = path == "-" ? cin : inFile;
+        mutex outputLock;
+        size_t requests = 0;
+        auto start = chrono::steady_clock::now();
+        {
+            SessionServer server(sis, defaultThreads(), [&](const Request& request, const string& result) {
+                lock_guard<mutex> guard(outputLock);
+                results << request.session << '\t' << result << '\n';
+            });
+            string line;
+            while (getline(in, line)) {
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (line.empty() || line[0] == '#') {
+                    continue;
+                }
+                vector<string> fields = WriteAheadLog::split(line);
+                string session = fields[0];
+                fields.erase(fields.begin());
+                server.submit(session, move(fields));
+                ++requests;
+            }
+        }
+        results.flush();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cerr << "Served " << requests << " requests in " << seconds << " s\n";
+        return true;
+    }
+
+    static void loadTest(size_t users, size_t opsPerUser) {
+        StudentInformationSystem sis(false);
+        for (int i = 0; i < 50; ++i) {
+            sis.executeShared({"notice-add", "General", "Semester notice " + to_string(i) + " about exams and fees"});
+            sis.executeShared({"book-add", "Book" + to_string(i)});
+        }
+        opsPerUser = max<size_t>(opsPerUser, 2);
+        vector<double> latencies(users * opsPerUser);
+        vector<uint32_t> progress(users, 0);
+        auto nextRequest = [&](size_t user) -> vector<string> {
+            uint32_t step = progress[user]++;
+            string name = "load" + to_string(user);
+            if (step == 0) {
+                return {"register-student", name, "pw", to_string(900000000 + user), "20", "100000"};
+            }
+            if (step == 1) {
+                return {"login", name, "pw"};
+            }
+            switch ((user * 7 + step * 13) % 10) {
+                case 0: case 1: case 2: case 3:
+                    return {"fees"};
+                case 4: case 5:
+                    return {"search", "semester exams"};
+                case 6:
+                    return {"pay", "1"};
+                case 7:
+                    return {"enroll", "C" + to_string(step % 8), "Course"};
+                case 8:
+                    return {"book-loans", name};
+                default:
+                    return {"notice-latest", "5"};
+            }
+        };
+        size_t threads = defaultThreads();
+        SessionServer* self = nullptr;
+        auto start = chrono::steady_clock::now();
+        {
+            SessionServer server(sis, threads, [&](const Request& request, const string&) {
+                latencies[request.tag] = chrono::duration<double, micro>(chrono::steady_clock::now() - request.submitted).count();
+                size_t user = stoul(request.session);
+                if (progress[user] < opsPerUser) {
+                    size_t tag = user * opsPerUser + progress[user];
+                    self->submit(request.session, nextRequest(user), tag);
+                }
+            });
+            self = &server;
+            for (size_t user = 0; user < users; ++user) {
+                server.submit(to_string(user), nextRequest(user), user * opsPerUser);
+            }
+            server.drain();
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double p) { return latencies[min(latencies.size() - 1, size_t(p * latencies.size()))]; };
+        cerr << users << " simulated users x " << opsPerUser << " requests on " << threads << " worker threads\n";
+        cerr << "Throughput: " << size_t(latencies.size() / seconds) << " requests/s\n";
+        cerr << fixed << setprecision(1) << "Latency p50: " << percentile(0.50) << " us, p99: " << percentile(0.99)
+             << " us, max: " << latencies.back() << " us\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && string(argv[1]) == "--batch") {
+        ostream results(cout.rdbuf());
+        OutputSilencer silencer;
+        StudentInformationSystem sis;
+        return sis.runBatch(argv[2], results) ? 0 : 1;
+    }
+    if (argc == 3 && string(argv[1]) == "--serve") {
+        ostream results(cout.rdbuf());
+        OutputSilencer silencer;
+        StudentInformationSystem sis;
+        return SessionServer::serve(sis, argv[2], results) ? 0 : 1;
+    }
+    if (argc == 4 && string(argv[1]) == "--load-test") {
+        OutputSilencer silencer;
+        SessionServer::loadTest(stoul(argv[2]), stoul(argv[3]));
+        return 0;
+    }
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "--transcripts") {
+        StudentInformationSystem sis;
+        return sis.generateTranscripts(argv[2], argc == 4 ? stoul(argv[3]) : max(1u, thread::hardware_concurrency())) ? 0 : 1;
+    }
+    if (argc == 5 && string(argv[1]) == "--export" && string(argv[4]) == "-") {
+        ostream results(cout.rdbuf());
+        OutputSilencer silencer;
+        StudentInformationSystem sis;
+        return sis.exportListing(argv[2], argv[3], results) ? 0 : 1;
+    }
+    if (argc == 5 && string(argv[1]) == "--export") {
+        StudentInformationSystem sis;
+        return sis.exportListing(argv[2], argv[3], argv[4]) ? 0 : 1;
+    }
+    if (argc == 3 && string(argv[1]) == "--post-payments") {
+        StudentInformationSystem sis;
+        return sis.postPaymentFile(argv[2]) ? 0 : 1;
+    }
+    if ((argc == 4 || argc == 5) && string(argv[1]) == "--fee-bench") {
+        StudentInformationSystem::benchmarkFeePosting(stoul(argv[2]), stoul(argv[3]), argc == 5 ? stoul(argv[4]) : 1000);
+        return 0;
+    }
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "--attendance-bench") {
+        StudentInformationSystem::benchmarkAttendance(stoul(argv[2]), argc == 4 ? stoul(argv[3]) : 45);
+        return 0;
+    }
+    if (argc == 3 && string(argv[1]) == "--login-bench") {
+        StudentInformationSystem::benchmarkLogin(stoul(argv[2]));
+        return 0;
+    }
+    if ((argc == 2 || argc == 3) && string(argv[1]) == "--stats-bench") {
+        StudentInformationSystem::benchmarkGradeStatistics(argc == 3 ? stoul(argv[2]) : 10000000);
+        return 0;
+    }
+    if ((argc == 2 || argc == 3) && string(argv[1]) == "--search-bench") {
+        StudentInformationSystem::benchmarkSearch(argc == 3 ? stoul(argv[2]) : 1000000);
+        return 0;
+    }
+    if ((argc == 2 || argc == 3) && string(argv[1]) == "--library-bench") {
+        StudentInformationSystem::benchmarkLibrary(argc == 3 ? stoul(argv[2]) : 1000000);
+        return 0;
+    }
+    if (argc == 2 && string(argv[1]) == "--check-journal") {
+        return StudentInformationSystem::checkJournalRoundTrip() ? 0 : 1;
+    }
+    if (argc == 2 && string(argv[1]) == "--check-aggregates") {
+        StudentInformationSystem sis;
+        return sis.checkAggregates() ? 0 : 1;
+    }
+    if (argc == 4 && string(argv[1]) == "--import") {
+        StudentInformationSystem sis;
+        return sis.importCsv(argv[2], argv[3]) ? 0 : 1;
+    }
     StudentInformationSystem sis;
     sis.run();
     return 0;